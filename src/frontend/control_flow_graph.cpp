@@ -2,25 +2,12 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <vector>
 #include "common/assert.h"
 #include "frontend/control_flow_graph.h"
 
 namespace Shader::Gcn {
 
-struct Compare {
-    bool operator()(const Block& lhs, u32 rhs) const noexcept {
-        return lhs.begin < rhs;
-    }
-
-    bool operator()(u32 lhs, const Block& rhs) const noexcept {
-        return lhs < rhs.begin;
-    }
-
-    bool operator()(const Block& lhs, const Block& rhs) const noexcept {
-        return lhs.begin < rhs.begin;
-    }
-};
-
 static IR::Condition MakeCondition(Opcode opcode) {
     switch (opcode){
     case Opcode::S_CBRANCH_SCC0:
@@ -40,30 +27,57 @@ static IR::Condition MakeCondition(Opcode opcode) {
     }
 }
 
-CFG::CFG(ObjectPool<Block>& block_pool_, std::span<const GcnInst> inst_list_)
-    : block_pool{block_pool_}, inst_list{inst_list_} {
-    index_to_pc.resize(inst_list.size());
+boost::container::small_vector<BlockIndex, 2> Block::Successors() const noexcept {
+    boost::container::small_vector<BlockIndex, 2> succs;
+    if (end_class != EndClass::Branch) {
+        return succs;
+    }
+    if (cond != IR::Condition::False) {
+        succs.push_back(branch_true);
+    }
+    if (cond != IR::Condition::True) {
+        succs.push_back(branch_false);
+    }
+    return succs;
+}
+
+CFG::CFG(std::span<const GcnInst> inst_list_, std::span<const u32> inst_pcs)
+    : inst_list{inst_list_} {
+    if (inst_pcs.empty()) {
+        index_to_pc.resize(inst_list.size());
+        u32 pc = 0;
+        for (u32 i = 0; i < inst_list.size(); i++) {
+            index_to_pc[i] = pc;
+            pc += inst_list[i].length;
+        }
+    } else {
+        ASSERT(inst_pcs.size() == inst_list.size());
+        index_to_pc.assign(inst_pcs.begin(), inst_pcs.end());
+    }
     EmitLabels();
     EmitBlocks();
     LinkBlocks();
 }
 
 void CFG::EmitLabels() {
-    // Always set a label at entry point.
-    u32 pc = 0;
-    labels.push_back(pc);
+    const u32 end_pc = inst_list.empty() ? 0 : index_to_pc.back() + inst_list.back().length;
 
-    const auto add_label = [this](u32 address) {
-        const auto it = std::ranges::find(labels, address);
-        if (it == labels.end()) {
-            labels.push_back(address);
-        }
+    // Labels are always dword aligned, so mark them in a map with one entry per dword.
+    // The map later resolves branch targets to the block starting at them.
+    label_to_block.assign(end_pc / sizeof(u32) + 1, InvalidBlock);
+    const auto add_label = [&](u32 address) {
+        ASSERT_MSG(address <= end_pc && address % sizeof(u32) == 0, "invalid label {:#x}",
+                   address);
+        label_to_block[address / sizeof(u32)] = 0;
     };
 
+    // Always set a label at entry point.
+    add_label(0);
+
     // Iterate instruction list and add labels to branch targets.
     for (u32 i = 0; i < inst_list.size(); i++) {
-        index_to_pc[i] = pc;
-        const GcnInst inst = inst_list[i];
+        const u32 pc = index_to_pc[i];
+        const GcnInst& inst = inst_list[i];
         if (inst.IsUnconditionalBranch()) {
             const u32 target = inst.BranchTarget(pc);
             add_label(target);
@@ -73,60 +87,69 @@ void CFG::EmitLabels() {
             add_label(true_label);
             add_label(false_label);
         } else if (inst.opcode == Opcode::S_ENDPGM) {
-            const u32 next_label = pc + inst.length;
+            // Unreachable code may have been skipped, so the next block starts
+            // at the next instruction rather than right after this one.
+            const bool is_last = i + 1 == inst_list.size();
+            const u32 next_label = is_last ? pc + inst.length : index_to_pc[i + 1];
             add_label(next_label);
         }
-        pc += inst.length;
     }
 
-    // Sort labels to make sure block insertion is correct.
-    std::ranges::sort(labels);
+    // The end of the last instruction closes the last block, which might not end the program.
+    if (!inst_list.empty()) {
+        add_label(end_pc);
+    }
+
+    // Walking the map in address order yields sorted and unique labels. Every label but
+    // the last one starts a block, so number them in the same order.
+    labels.clear();
+    for (u32 i = 0; i < label_to_block.size(); i++) {
+        if (label_to_block[i] != InvalidBlock) {
+            label_to_block[i] = static_cast<BlockIndex>(labels.size());
+            labels.push_back(i * sizeof(u32));
+        }
+    }
 }
 
 void CFG::EmitBlocks() {
-    const auto get_index = [this](Label label) -> size_t {
-        if (label == 0) {
-            return 0ULL;
+    // Labels and instructions are both sorted by address, so a single sweep
+    // over the instructions finds the range of every block.
+    blocks.reserve(labels.size());
+    u32 index = 0;
+    for (size_t i = 0; i + 1 < labels.size(); i++) {
+        const Label start = labels[i];
+        const Label end = labels[i + 1];
+        while (index < inst_list.size() && index_to_pc[index] < start) {
+            ++index;
         }
-        const auto it_index = std::ranges::lower_bound(index_to_pc, label);
-        ASSERT(it_index != index_to_pc.end() || label > index_to_pc.back());
-        return std::distance(index_to_pc.begin(), std::prev(it_index));
-    };
-
-    for (auto it = labels.begin(); it != labels.end(); it++) {
-        const Label start = *it;
-        const auto next_it = std::next(it);
-        const bool is_last = next_it == labels.end();
-        if (is_last) {
-            // Last label is special.
-            return;
+        const u32 begin_index = index;
+        ASSERT_MSG(begin_index < inst_list.size() && index_to_pc[begin_index] == start,
+                   "label {:#x} is not at an instruction boundary", start);
+        while (index < inst_list.size() && index_to_pc[index] < end) {
+            ++index;
         }
-        const Label end = *next_it;
-        const size_t end_index = get_index(end);
-        const auto& end_inst = inst_list[end_index];
+        const u32 end_index = index - 1;
 
         // Insert block between the labels using the last instruction
         // as an indicator for branching type.
-        Block* block = block_pool.Create();
-        block->begin = start;
-        block->end = end;
-        block->begin_index = get_index(start);
-        block->end_index = end_index;
-        block->end_inst = end_inst;
-        block->cond = MakeCondition(end_inst.opcode);
-        blocks.insert(*block);
+        Block& block = blocks.emplace_back();
+        block.begin = start;
+        block.end = end;
+        block.begin_index = begin_index;
+        block.end_index = end_index;
+        block.cond = MakeCondition(inst_list[end_index].opcode);
     }
 }
 
 void CFG::LinkBlocks() {
     const auto get_block = [this](u32 address) {
-        const auto it = blocks.find(address, Compare{});
-        ASSERT_MSG(it != blocks.end() && it->begin == address);
-        return &*it;
+        const BlockIndex index = label_to_block[address / sizeof(u32)];
+        ASSERT_MSG(index < blocks.size(), "no block starts at {:#x}", address);
+        return index;
     };
 
     for (auto& block : blocks) {
-        const auto end_inst{block.end_inst};
+        const GcnInst& end_inst = EndInst(block);
         // If the block doesn't end with a branch we simply
         // need to link with the next block.
         if (!end_inst.IsTerminateInstruction()) {
@@ -136,8 +159,7 @@ void CFG::LinkBlocks() {
         }
 
         // Find the branch targets from the instruction and link the blocks.
-        // Note: Block end address is one instruction after end_inst.
-        const u32 branch_pc = block.end - end_inst.length;
+        const u32 branch_pc = index_to_pc[block.end_index];
         const u32 target_pc = end_inst.BranchTarget(branch_pc);
         if (end_inst.IsUnconditionalBranch()) {
             block.branch_true = get_block(target_pc);
@@ -153,6 +175,106 @@ void CFG::LinkBlocks() {
     }
 }
 
+void CFG::Simplify() {
+    if (blocks.empty()) {
+        return;
+    }
+    // The block indices are about to change.
+    analysis.reset();
+
+    // Mark the blocks reachable from the entry.
+    std::vector<bool> reachable(blocks.size());
+    boost::container::small_vector<BlockIndex, 16> worklist{0};
+    reachable[0] = true;
+    while (!worklist.empty()) {
+        const BlockIndex index = worklist.back();
+        worklist.pop_back();
+        for (const BlockIndex succ : blocks[index].Successors()) {
+            if (!reachable[succ]) {
+                reachable[succ] = true;
+                worklist.push_back(succ);
+            }
+        }
+    }
+
+    // Only reachable predecessors prevent a merge.
+    std::vector<u32> num_preds(blocks.size());
+    for (BlockIndex index = 0; index < blocks.size(); index++) {
+        if (reachable[index]) {
+            for (const BlockIndex succ : blocks[index].Successors()) {
+                ++num_preds[succ];
+            }
+        }
+    }
+
+    // Merge fall through chains. The successor must follow in the instruction list, so the
+    // merged block still covers a single range of instructions.
+    std::vector<bool> keep{reachable};
+    for (BlockIndex index = 0; index < blocks.size(); index++) {
+        if (!keep[index]) {
+            continue;
+        }
+        Block& block = blocks[index];
+        while (block.end_class == EndClass::Branch && block.cond == IR::Condition::True &&
+               !EndInst(block).IsTerminateInstruction()) {
+            const BlockIndex succ_index = block.branch_true;
+            const Block& succ = blocks[succ_index];
+            if (succ_index == 0 || succ_index == index || num_preds[succ_index] != 1 ||
+                succ.begin_index != block.end_index + 1) {
+                break;
+            }
+            block.end = succ.end;
+            block.end_index = succ.end_index;
+            block.cond = succ.cond;
+            block.end_class = succ.end_class;
+            block.branch_true = succ.branch_true;
+            block.branch_false = succ.branch_false;
+            keep[succ_index] = false;
+        }
+    }
+
+    // Compact the remaining blocks and renumber their successors.
+    std::vector<BlockIndex> remap(blocks.size(), InvalidBlock);
+    BlockIndex num_blocks = 0;
+    for (BlockIndex index = 0; index < blocks.size(); index++) {
+        if (keep[index]) {
+            remap[index] = num_blocks;
+            blocks[num_blocks++] = blocks[index];
+        }
+    }
+    blocks.resize(num_blocks);
+
+    const Label end_label = labels.back();
+    labels.clear();
+    std::ranges::fill(label_to_block, InvalidBlock);
+    for (BlockIndex index = 0; index < blocks.size(); index++) {
+        Block& block = blocks[index];
+        if (block.branch_true != InvalidBlock) {
+            block.branch_true = remap[block.branch_true];
+        }
+        if (block.branch_false != InvalidBlock) {
+            block.branch_false = remap[block.branch_false];
+        }
+        labels.push_back(block.begin);
+        label_to_block[block.begin / sizeof(u32)] = index;
+    }
+    labels.push_back(end_label);
+}
+
+IR::FlowAnalysis& CFG::Analysis() {
+    if (!analysis) {
+        std::vector<std::pair<IR::NodeIndex, IR::NodeIndex>> edges;
+        edges.reserve(blocks.size() * 2);
+        for (BlockIndex index = 0; index < blocks.size(); index++) {
+            for (const BlockIndex succ : blocks[index].Successors()) {
+                edges.emplace_back(index, succ);
+            }
+        }
+        analysis.emplace(IR::FlowGraph{static_cast<u32>(blocks.size()), 0, edges});
+    }
+    return *analysis;
+}
+
 std::string CFG::Dot() const {
     int node_uid{0};
 
@@ -165,8 +287,8 @@ std::string CFG::Dot() const {
     dot += fmt::format("\t\tnode [style=filled];\n");
     for (const Block& block : blocks) {
         const std::string name{name_of(block)};
-        const auto add_branch = [&](Block* branch, bool add_label) {
-            dot += fmt::format("\t\t{}->{}", name, name_of(*branch));
+        const auto add_branch = [&](BlockIndex branch, bool add_label) {
+            dot += fmt::format("\t\t{}->{}", name, name_of(blocks[branch]));
             if (add_label && block.cond != IR::Condition::True &&
                 block.cond != IR::Condition::False) {
                 dot += fmt::format(" [label=\"{}\"]", block.cond);
@@ -201,7 +323,7 @@ std::string CFG::Dot() const {
     if (blocks.empty()) {
         dot += "Start;\n";
     } else {
-        dot += fmt::format("\tStart -> {};\n", name_of(*blocks.begin()));
+        dot += fmt::format("\tStart -> {};\n", name_of(blocks.front()));
     }
     dot += fmt::format("\tStart [shape=diamond];\n");
     dot += "}\n";
@@ -3,50 +3,65 @@
 
 #pragma once
 
+#include <limits>
+#include <optional>
 #include <string>
 #include <span>
+#include <vector>
 #include <boost/container/small_vector.hpp>
-#include <boost/intrusive/set.hpp>
 
 #include "common/types.h"
 #include "ir/condition.h"
+#include "ir/dominance.h"
 #include "frontend/instruction.h"
-#include "object_pool.h"
 
 namespace Shader::Gcn {
 
-using Hook = boost::intrusive::set_base_hook<
-             boost::intrusive::link_mode<boost::intrusive::normal_link>>;
-
 enum class EndClass {
     Branch,         ///< Block ends with a (un)conditional branch.
     Exit,           ///< Block ends with an exit instruction.
 };
 
+/// Index of a block in CFG::blocks.
+using BlockIndex = u32;
+constexpr BlockIndex InvalidBlock = std::numeric_limits<BlockIndex>::max();
+
 /// A block represents a linear range of instructions.
-struct Block : Hook {
+struct Block {
     [[nodiscard]] bool Contains(u32 pc) const noexcept;
 
-    bool operator<(const Block& rhs) const noexcept {
-        return begin < rhs.begin;
-    }
+    /// Returns the blocks control can flow to, the taken branch first.
+    [[nodiscard]] boost::container::small_vector<BlockIndex, 2> Successors() const noexcept;
 
     u32 begin;
     u32 end;
     u32 begin_index;
-    u32 end_index;
+    u32 end_index; ///< Index of the instruction that ends the block.
     IR::Condition cond{};
-    GcnInst end_inst{};
     EndClass end_class{};
-    Block* branch_true{};
-    Block* branch_false{};
+    BlockIndex branch_true = InvalidBlock;
+    BlockIndex branch_false = InvalidBlock;
 };
 
 class CFG {
     using Label = u32;
 public:
-    explicit CFG(ObjectPool<Block>& block_pool,
-                 std::span<const GcnInst> inst_list);
+    /// inst_pcs holds the byte address of each instruction. When empty the instructions
+    /// are assumed to be contiguous from address zero.
+    explicit CFG(std::span<const GcnInst> inst_list, std::span<const u32> inst_pcs = {});
+
+    /// Returns the instruction that ends the block.
+    [[nodiscard]] const GcnInst& EndInst(const Block& block) const noexcept {
+        return inst_list[block.end_index];
+    }
+
+    /// Removes blocks that are not reachable from the entry and merges blocks that fall through
+    /// into a successor with no other predecessor. Blocks stay sorted by address.
+    void Simplify();
+
+    /// Returns dominance and loop information of the blocks, where node i is blocks[i].
+    /// Computed on first use and kept until the blocks change.
+    [[nodiscard]] IR::FlowAnalysis& Analysis();
 
     [[nodiscard]] std::string Dot() const;
 
@@ -56,11 +71,14 @@ private:
     void LinkBlocks();
 
 public:
-    ObjectPool<Block>& block_pool;
     std::span<const GcnInst> inst_list;
     std::vector<u32> index_to_pc;
     boost::container::small_vector<Label, 16> labels;
-    boost::intrusive::set<Block> blocks;
+    std::vector<BlockIndex> label_to_block; ///< Block starting at each dword, if any.
+    std::vector<Block> blocks;              ///< Blocks sorted by address.
+
+private:
+    std::optional<IR::FlowAnalysis> analysis;
 };
 
 } // namespace Shader::Gcn
@@ -2,7 +2,18 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <array>
+#include <exception>
+#include <thread>
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+#include <boost/container/small_vector.hpp>
 #include "common/assert.h"
+#include "exception.h"
 #include "frontend/decode.h"
 
 namespace Shader::Gcn {
@@ -14,7 +25,10 @@ T extract(T value, u32 lst, u32 fst) {
 }
 } // namespace bit
 
-InstEncoding GetInstructionEncoding(u32 token) {
+namespace {
+
+/// Tests the encoding masks from the most to the least specific one.
+constexpr InstEncoding ClassifyEncodingMasks(u32 token) {
     auto encoding = static_cast<InstEncoding>(token & (u32)EncodingMask::MASK_9bit);
     switch (encoding) {
     case InstEncoding::SOP1:
@@ -80,186 +94,385 @@ InstEncoding GetInstructionEncoding(u32 token) {
         break;
     }
 
-    UNREACHABLE();
     return InstEncoding::ILLEGAL;
 }
 
-bool HasAdditionalLiteral(InstEncoding encoding, Opcode opcode) {
+constexpr u32 EncodingLength(InstEncoding encoding) {
     switch (encoding) {
-    case InstEncoding::SOPK: {
-        return opcode == Opcode::S_SETREG_IMM32_B32;
-    }
-    case InstEncoding::VOP2: {
-        return opcode == Opcode::V_MADMK_F32 || opcode == Opcode::V_MADAK_F32;
-    }
+    case InstEncoding::SOP1:
+    case InstEncoding::SOPP:
+    case InstEncoding::SOPC:
+    case InstEncoding::SOPK:
+    case InstEncoding::SOP2:
+    case InstEncoding::VOP1:
+    case InstEncoding::VOPC:
+    case InstEncoding::VOP2:
+    case InstEncoding::SMRD:
+    case InstEncoding::VINTRP:
+        return sizeof(u32);
+    case InstEncoding::VOP3:
+    case InstEncoding::MUBUF:
+    case InstEncoding::MTBUF:
+    case InstEncoding::MIMG:
+    case InstEncoding::DS:
+    case InstEncoding::EXP:
+        return sizeof(u64);
     default:
-        return false;
+        return 0;
     }
 }
 
-bool IsVop3BEncoding(Opcode opcode) {
-    return opcode == Opcode::V_ADD_I32 || opcode == Opcode::V_ADDC_U32 ||
-           opcode == Opcode::V_SUB_I32 || opcode == Opcode::V_SUBB_U32 ||
-           opcode == Opcode::V_SUBREV_I32 || opcode == Opcode::V_SUBBREV_U32 ||
-           opcode == Opcode::V_DIV_SCALE_F32 || opcode == Opcode::V_DIV_SCALE_F64 ||
-           opcode == Opcode::V_MAD_U64_U32 || opcode == Opcode::V_MAD_I64_I32;
+/// Every encoding is identified by bits [31:23] of its first dword,
+/// so the classification can be precomputed for all 512 prefixes.
+constexpr u32 EncodingPrefixShift = 23;
+
+constexpr auto EncodingTable = [] {
+    std::array<EncodingInfo, 1U << (32 - EncodingPrefixShift)> table{};
+    for (u32 prefix = 0; prefix < table.size(); ++prefix) {
+        const InstEncoding encoding = ClassifyEncodingMasks(prefix << EncodingPrefixShift);
+        table[prefix] = {encoding, EncodingLength(encoding)};
+    }
+    return table;
+}();
+
+static_assert(EncodingTable[0x17D].encoding == InstEncoding::SOP1);
+static_assert(EncodingTable[0x1A0].encoding == InstEncoding::VOP3);
+static_assert(EncodingTable[0x1A0].length == sizeof(u64));
+static_assert(EncodingTable[0x1FF].encoding == InstEncoding::ILLEGAL);
+
+} // Anonymous namespace
+
+EncodingInfo GetEncodingInfo(u32 token) {
+    return EncodingTable[token >> EncodingPrefixShift];
 }
 
-GcnInst GcnDecodeContext::decodeInstruction(GcnCodeSlice& code) {
-    const uint32_t token = code.at(0);
+InstEncoding GetInstructionEncoding(u32 token) {
+    return EncodingTable[token >> EncodingPrefixShift].encoding;
+}
 
-    InstEncoding encoding = GetInstructionEncoding(token);
-    ASSERT_MSG(encoding != InstEncoding::ILLEGAL, "illegal encoding");
-    uint32_t encodingLen = getEncodingLength(encoding);
+InstEncoding ClassifyInstructionEncoding(u32 token) {
+    return ClassifyEncodingMasks(token);
+}
 
-    // Clear the instruction
-    m_instruction = GcnInst();
+u32 GetEncodingLength(InstEncoding encoding) {
+    return EncodingLength(encoding);
+}
 
-    // Decode
-    if (encodingLen == sizeof(uint32_t)) {
-        decodeInstruction32(encoding, code);
-    } else {
-        decodeInstruction64(encoding, code);
+namespace {
+
+void ClassifyTokensScalar(std::span<const u32> tokens, std::span<EncodingInfo> out) {
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        out[i] = EncodingTable[tokens[i] >> EncodingPrefixShift];
     }
+}
 
-    // Update instruction meta info.
-    updateInstructionMeta(encoding);
+#if defined(__x86_64__) || defined(_M_X64)
+
+#ifdef _MSC_VER
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+static_assert(sizeof(EncodingInfo) == sizeof(u64));
+
+/// Table entries are copied as a whole, so eight tokens take two 64 bit gathers
+/// of four prefixes each and two stores.
+TARGET_AVX2 void ClassifyTokensAvx2(std::span<const u32> tokens, std::span<EncodingInfo> out) {
+    const auto* table = reinterpret_cast<const long long*>(EncodingTable.data());
+    const size_t num_vectors = tokens.size() / 8;
+    for (size_t i = 0; i < num_vectors; ++i) {
+        const __m256i token =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tokens.data() + i * 8));
+        const __m256i prefix = _mm256_srli_epi32(token, EncodingPrefixShift);
+        const __m256i lo = _mm256_i32gather_epi64(table, _mm256_castsi256_si128(prefix), 8);
+        const __m256i hi = _mm256_i32gather_epi64(table, _mm256_extracti128_si256(prefix, 1), 8);
+        auto* const dst = reinterpret_cast<__m256i*>(out.data() + i * 8);
+        _mm256_storeu_si256(dst, lo);
+        _mm256_storeu_si256(dst + 1, hi);
+    }
+    const size_t tail = num_vectors * 8;
+    ClassifyTokensScalar(tokens.subspan(tail), out.subspan(tail));
+}
 
-    // Detect literal constant. Only 32 bits instructions may have literal constant.
-    // Note: Literal constant decode must be performed after meta info updated.
-    if (encodingLen == sizeof(u32)) {
-        decodeLiteralConstant(encoding, code);
+#undef TARGET_AVX2
+
+bool HasAvx2() {
+#ifdef _MSC_VER
+    int regs[4];
+    __cpuid(regs, 0);
+    if (regs[0] < 7) {
+        return false;
     }
+    __cpuid(regs, 1);
+    // The OS must save the ymm registers on context switch.
+    const bool osxsave = (regs[2] & (1 << 27)) != 0;
+    if (!osxsave || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
 
-    repairOperandType();
-    return m_instruction;
+#endif
+
+using ClassifyTokensFunc = void (*)(std::span<const u32>, std::span<EncodingInfo>);
+
+ClassifyTokensFunc SelectClassifyTokens() {
+#if defined(__x86_64__) || defined(_M_X64)
+    if (HasAvx2()) {
+        return ClassifyTokensAvx2;
+    }
+#endif
+    return ClassifyTokensScalar;
+}
+
+} // Anonymous namespace
+
+void ClassifyTokens(std::span<const u32> tokens, std::span<EncodingInfo> out) {
+    static const ClassifyTokensFunc func = SelectClassifyTokens();
+    ASSERT(out.size() >= tokens.size());
+    func(tokens, out);
+}
+
+bool IsVectorClassifySupported() {
+    static const bool supported = SelectClassifyTokens() != ClassifyTokensScalar;
+    return supported;
 }
 
-uint32_t GcnDecodeContext::getEncodingLength(InstEncoding encoding) {
-    uint32_t instLength = 0;
+namespace {
 
+/// Mirrors decodeLiteralConstant using only the first dword of a 32 bit instruction.
+bool HasLiteralConstant(InstEncoding encoding, u32 token) {
+    const auto is_literal = [](u32 code) {
+        return code == static_cast<u32>(OperandField::LiteralConst);
+    };
     switch (encoding) {
-    case InstEncoding::SOP1:
-    case InstEncoding::SOPP:
+    case InstEncoding::SOP2:
     case InstEncoding::SOPC:
+        return is_literal(bit::extract(token, 7, 0)) || is_literal(bit::extract(token, 15, 8));
+    case InstEncoding::SOP1:
+        return is_literal(bit::extract(token, 7, 0));
     case InstEncoding::SOPK:
-    case InstEncoding::SOP2:
+        return bit::extract(token, 27, 23) == static_cast<u32>(OpcodeSOPK::S_SETREG_IMM32_B32);
     case InstEncoding::VOP1:
     case InstEncoding::VOPC:
-    case InstEncoding::VOP2:
+        return is_literal(bit::extract(token, 8, 0));
+    case InstEncoding::VOP2: {
+        const auto op = static_cast<OpcodeVOP2>(bit::extract(token, 30, 25));
+        if (op == OpcodeVOP2::V_MADMK_F32 || op == OpcodeVOP2::V_MADAK_F32) {
+            return true;
+        }
+        // vsrc1 is scalar for lane instructions
+        const bool is_lane = op == OpcodeVOP2::V_READLANE_B32 || op == OpcodeVOP2::V_WRITELANE_B32;
+        return is_literal(bit::extract(token, 8, 0)) ||
+               (is_lane && is_literal(bit::extract(token, 16, 9)));
+    }
     case InstEncoding::SMRD:
-    case InstEncoding::VINTRP:
-        instLength = sizeof(uint32_t);
-        break;
+        // Register offset, the immediate flag is clear
+        return bit::extract(token, 8, 8) == 0 && is_literal(bit::extract(token, 7, 0));
+    default:
+        return false;
+    }
+}
 
-    case InstEncoding::VOP3:
-    case InstEncoding::MUBUF:
-    case InstEncoding::MTBUF:
-    case InstEncoding::MIMG:
-    case InstEncoding::DS:
-    case InstEncoding::EXP:
-        instLength = sizeof(uint64_t);
-        break;
+} // Anonymous namespace
+
+u32 GetInstructionSize(u32 token) {
+    const auto [encoding, length] = GetEncodingInfo(token);
+    const u32 size = length / sizeof(u32);
+    if (size == 1 && HasLiteralConstant(encoding, token)) {
+        return size + 1;
     }
-    return instLength;
+    return size;
 }
 
-uint32_t GcnDecodeContext::getOpMapOffset(InstEncoding encoding) {
-    uint32_t offset = 0;
-    switch (encoding) {
-    case InstEncoding::SOP1:
-        offset = (uint32_t)OpcodeMap::OP_MAP_SOP1;
-        break;
-    case InstEncoding::SOPP:
-        offset = (uint32_t)OpcodeMap::OP_MAP_SOPP;
-        break;
-    case InstEncoding::SOPC:
-        offset = (uint32_t)OpcodeMap::OP_MAP_SOPC;
-        break;
-    case InstEncoding::VOP1:
-        offset = (uint32_t)OpcodeMap::OP_MAP_VOP1;
-        break;
-    case InstEncoding::VOPC:
-        offset = (uint32_t)OpcodeMap::OP_MAP_VOPC;
-        break;
-    case InstEncoding::VOP3:
-        offset = (uint32_t)OpcodeMap::OP_MAP_VOP3;
-        break;
-    case InstEncoding::EXP:
-        offset = (uint32_t)OpcodeMap::OP_MAP_EXP;
-        break;
-    case InstEncoding::VINTRP:
-        offset = (uint32_t)OpcodeMap::OP_MAP_VINTRP;
-        break;
-    case InstEncoding::DS:
-        offset = (uint32_t)OpcodeMap::OP_MAP_DS;
-        break;
-    case InstEncoding::MUBUF:
-        offset = (uint32_t)OpcodeMap::OP_MAP_MUBUF;
-        break;
-    case InstEncoding::MTBUF:
-        offset = (uint32_t)OpcodeMap::OP_MAP_MTBUF;
-        break;
-    case InstEncoding::MIMG:
-        offset = (uint32_t)OpcodeMap::OP_MAP_MIMG;
-        break;
-    case InstEncoding::SMRD:
-        offset = (uint32_t)OpcodeMap::OP_MAP_SMRD;
-        break;
-    case InstEncoding::SOPK:
-        offset = (uint32_t)OpcodeMap::OP_MAP_SOPK;
-        break;
-    case InstEncoding::SOP2:
-        offset = (uint32_t)OpcodeMap::OP_MAP_SOP2;
-        break;
-    case InstEncoding::VOP2:
-        offset = (uint32_t)OpcodeMap::OP_MAP_VOP2;
-        break;
+std::vector<u32> ScanInstructionOffsets(std::span<const u32> code) {
+    std::vector<u32> offsets;
+    offsets.reserve(code.size());
+    u32 pc = 0;
+    while (pc < code.size()) {
+        const u32 size = GetInstructionSize(code[pc]);
+        if (size == 0) {
+            throw InvalidArgument("Illegal encoding {:#x} at {:#x}", code[pc], pc * sizeof(u32));
+        }
+        if (pc + size > code.size()) {
+            // Instruction is truncated
+            break;
+        }
+        offsets.push_back(pc);
+        pc += size;
     }
-    return offset;
+    return offsets;
 }
 
-uint32_t GcnDecodeContext::mapEncodingOp(InstEncoding encoding, Opcode opcode) {
-    // Map from uniform opcode to encoding specific opcode.
-    uint32_t encodingOp = 0;
-    if (encoding == InstEncoding::VOP3) {
-        if (opcode >= Opcode::V_CMP_F_F32 && opcode <= Opcode::V_CMPX_T_U64) {
-            uint32_t op =
-                static_cast<uint32_t>(opcode) - static_cast<uint32_t>(OpcodeMap::OP_MAP_VOPC);
-            encodingOp = op + static_cast<uint32_t>(OpMapVOP3VOPX::VOP3_TO_VOPC);
-        } else if (opcode >= Opcode::V_CNDMASK_B32 && opcode <= Opcode::V_CVT_PK_I16_I32) {
-            uint32_t op =
-                static_cast<uint32_t>(opcode) - static_cast<uint32_t>(OpcodeMap::OP_MAP_VOP2);
-            encodingOp = op + static_cast<uint32_t>(OpMapVOP3VOPX::VOP3_TO_VOP2);
-        } else if (opcode >= Opcode::V_NOP && opcode <= Opcode::V_MOVRELSD_B32) {
-            uint32_t op =
-                static_cast<uint32_t>(opcode) - static_cast<uint32_t>(OpcodeMap::OP_MAP_VOP1);
-            encodingOp = op + static_cast<uint32_t>(OpMapVOP3VOPX::VOP3_TO_VOP1);
-        } else {
-            encodingOp =
-                static_cast<uint32_t>(opcode) - static_cast<uint32_t>(OpcodeMap::OP_MAP_VOP3);
+void DecodeParallel(std::span<const u32> code, std::span<const u32> offsets,
+                    std::span<GcnInst> out) {
+    ASSERT(out.size() >= offsets.size());
+    const auto decode_chunk = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            GcnCodeSlice slice(code.data() + offsets[i], code.data() + code.size());
+            GcnDecodeContext{out[i]}.decodeInstruction(slice);
+            DEBUG_ASSERT(out[i].length == GetInstructionSize(code[offsets[i]]) * sizeof(u32));
+        }
+    };
+
+    // Spawning threads only pays off for large shaders.
+    constexpr size_t MinChunkSize = 4096;
+    const size_t max_threads = std::max(1U, std::thread::hardware_concurrency());
+    const size_t num_chunks = std::min(max_threads, offsets.size() / MinChunkSize);
+    if (num_chunks <= 1) {
+        decode_chunk(0, offsets.size());
+        return;
+    }
+    const size_t chunk_size = (offsets.size() + num_chunks - 1) / num_chunks;
+    // Exceptions cannot leave a worker, they are rethrown once every worker has joined.
+    std::vector<std::exception_ptr> errors(num_chunks);
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(num_chunks - 1);
+        std::exception_ptr* error = errors.data();
+        for (size_t begin = chunk_size; begin < offsets.size(); begin += chunk_size) {
+            const size_t end = std::min(begin + chunk_size, offsets.size());
+            workers.emplace_back([&decode_chunk, begin, end, error = ++error] {
+                try {
+                    decode_chunk(begin, end);
+                } catch (...) {
+                    *error = std::current_exception();
+                }
+            });
+        }
+        decode_chunk(0, chunk_size);
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
         }
-    } else {
-        uint32_t mapOffset = getOpMapOffset(encoding);
-        encodingOp = static_cast<uint32_t>(opcode) - mapOffset;
     }
+}
+
+DecodeResult DecodeRange(std::span<const u32> code, std::span<GcnInst> out) {
+    DecodeResult result{};
+    while (result.num_dwords < code.size() && result.num_insts < out.size()) {
+        const u32 token = code[result.num_dwords];
+        const u32 size = GetInstructionSize(token);
+        if (size == 0) {
+            throw InvalidArgument("Illegal encoding {:#x} at {:#x}", token,
+                                  result.num_dwords * sizeof(u32));
+        }
+        if (result.num_dwords + size > code.size()) {
+            // Instruction is truncated, leave it for the next call
+            break;
+        }
+        GcnCodeSlice slice(code.data() + result.num_dwords, code.data() + code.size());
+        GcnDecodeContext{out[result.num_insts++]}.decodeInstruction(slice);
+        result.num_dwords += size;
+    }
+    return result;
+}
 
-    return encodingOp;
+std::vector<u32> ScanReachableOffsets(std::span<const u32> code) {
+    std::vector<u32> offsets;
+    std::vector<bool> visited(code.size());
+    boost::container::small_vector<u32, 16> worklist{0};
+    while (!worklist.empty()) {
+        u32 pc = worklist.back();
+        worklist.pop_back();
+        while (pc < code.size() && !visited[pc]) {
+            const u32 token = code[pc];
+            const u32 size = GetInstructionSize(token);
+            if (size == 0) {
+                throw InvalidArgument("Illegal encoding {:#x} at {:#x}", token, pc * sizeof(u32));
+            }
+            if (pc + size > code.size()) {
+                throw InvalidArgument("Instruction at {:#x} is truncated", pc * sizeof(u32));
+            }
+            visited[pc] = true;
+            offsets.push_back(pc);
+            if (GetInstructionEncoding(token) != InstEncoding::SOPP) {
+                pc += size;
+                continue;
+            }
+            // Branches are the only instructions that affect the walk, read them off the token.
+            const auto op = static_cast<OpcodeSOPP>(bit::extract(token, 22, 16));
+            const u32 branch_pc = pc * sizeof(u32);
+            const s32 offset = static_cast<s16>(bit::extract(token, 15, 0)) * 4;
+            const u32 target = (branch_pc + offset + 4) / sizeof(u32);
+            if (op == OpcodeSOPP::S_ENDPGM) {
+                break;
+            }
+            if (op == OpcodeSOPP::S_BRANCH) {
+                pc = target;
+                continue;
+            }
+            if (op >= OpcodeSOPP::S_CBRANCH_SCC0 && op <= OpcodeSOPP::S_CBRANCH_EXECNZ) {
+                worklist.push_back(target);
+            }
+            pc += size;
+        }
+    }
+    std::ranges::sort(offsets);
+    return offsets;
+}
+
+ReachableCode DecodeReachable(std::span<const u32> code) {
+    const std::vector<u32> offsets = ScanReachableOffsets(code);
+    ReachableCode result{};
+    result.insts.resize(offsets.size());
+    DecodeParallel(code, offsets, result.insts);
+    result.pcs.reserve(offsets.size());
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        const u32 pc = offsets[i] * sizeof(u32);
+        result.pcs.push_back(pc);
+        result.end = std::max<u32>(result.end, pc + result.insts[i].length);
+    }
+    return result;
 }
 
-void GcnDecodeContext::updateInstructionMeta(InstEncoding encoding) {
-    uint32_t encodingOp = mapEncodingOp(encoding, m_instruction.opcode);
-    InstFormat instFormat = InstructionFormat(encoding, encodingOp);
+void GcnDecodeContext::decodeInstruction(GcnCodeSlice& code) {
+    const uint32_t token = code.at(0);
+
+    const auto [encoding, encodingLen] = GetEncodingInfo(token);
+    if (encoding == InstEncoding::ILLEGAL) {
+        throw InvalidArgument("Illegal encoding {:#x}", token);
+    }
+
+    // Clear the instruction
+    m_instruction = DecodedInst();
+
+    // Decode
+    if (encodingLen == sizeof(uint32_t)) {
+        decodeInstruction32(encoding, code);
+    } else {
+        decodeInstruction64(encoding, code);
+    }
+
+    // Update instruction meta info.
+    const InstInfo& info = GetInstInfo(encoding, m_instruction.opcode);
+    if (info.length == 0) {
+        throw InvalidArgument("Illegal opcode {}", static_cast<u32>(m_instruction.opcode));
+    }
+    updateInstructionMeta(encoding, info);
 
-    ASSERT_MSG(instFormat.src_type != ScalarType::Undefined &&
-                   instFormat.dst_type != ScalarType::Undefined,
-               "TODO: Instruction format table not complete, please fix it manually.");
+    // Detect literal constant. Only 32 bits instructions may have literal constant.
+    // Note: Literal constant decode must be performed after meta info updated.
+    if (encodingLen == sizeof(u32)) {
+        decodeLiteralConstant(info, code);
+    }
+
+    repairOperandType();
+    packInstruction();
+}
+
+void GcnDecodeContext::updateInstructionMeta(InstEncoding encoding, const InstInfo& info) {
+    const InstFormat& instFormat = info.format;
 
-    m_instruction.inst_class = instFormat.inst_class;
-    m_instruction.category = instFormat.inst_category;
     m_instruction.encoding = encoding;
     m_instruction.src_count = instFormat.src_count;
-    m_instruction.length = getEncodingLength(encoding);
+    m_instruction.length = info.length;
 
     // Update src operand scalar type.
     auto setOperandType = [&instFormat](InstOperand& src) {
@@ -310,6 +523,29 @@ void GcnDecodeContext::repairOperandType() {
     }
 }
 
+void GcnDecodeContext::packInstruction() {
+    m_output = GcnInst{};
+    m_output.control = m_instruction.control;
+    m_output.opcode = m_instruction.opcode;
+    m_output.length = static_cast<u8>(m_instruction.length);
+    m_output.src_count = m_instruction.src_count;
+    m_output.dst_count = m_instruction.dst_count;
+    m_output.is_vop3 = m_instruction.encoding == InstEncoding::VOP3;
+
+    // At most one literal constant follows the instruction.
+    const auto it = std::ranges::find(m_instruction.src, OperandField::LiteralConst,
+                                      &InstOperand::field);
+    if (it != m_instruction.src.end()) {
+        m_output.literal = it->code;
+    }
+    for (u32 i = 0; i < GcnMaxSrcCount; ++i) {
+        m_output.SetSrc(i, m_instruction.src[i]);
+    }
+    for (u32 i = 0; i < GcnMaxDstCount; ++i) {
+        m_output.SetDst(i, m_instruction.dst[i]);
+    }
+}
+
 OperandField GcnDecodeContext::getOperandField(uint32_t code) {
     OperandField field = {};
     if (code >= ScalarGPRMin && code <= ScalarGPRMax) {
@@ -386,12 +622,10 @@ void GcnDecodeContext::decodeInstruction64(InstEncoding encoding, GcnCodeSlice&
     }
 }
 
-void GcnDecodeContext::decodeLiteralConstant(InstEncoding encoding, GcnCodeSlice& code) {
-    if (HasAdditionalLiteral(encoding, m_instruction.opcode)) {
-        u32 encoding_op = mapEncodingOp(encoding, m_instruction.opcode);
-        InstFormat instFormat = InstructionFormat(encoding, encoding_op);
+void GcnDecodeContext::decodeLiteralConstant(const InstInfo& info, GcnCodeSlice& code) {
+    if (info.has_literal) {
         m_instruction.src[m_instruction.src_count].field = OperandField::LiteralConst;
-        m_instruction.src[m_instruction.src_count].type = instFormat.src_type;
+        m_instruction.src[m_instruction.src_count].type = info.format.src_type;
         m_instruction.src[m_instruction.src_count].code = code.readu32();
         ++m_instruction.src_count;
         m_instruction.length += sizeof(u32);
@@ -540,7 +774,7 @@ void GcnDecodeContext::decodeInstructionVOP2(u32 hexInstruction) {
         m_instruction.dst[1].field = OperandField::ScalarGPR;
         m_instruction.dst[1].type = ScalarType::Uint32;
         m_instruction.dst[1].code = vdst;
-    } else if (IsVop3BEncoding(m_instruction.opcode)) {
+    } else if (GetInstInfo(InstEncoding::VOP2, m_instruction.opcode).is_vop3b) {
         m_instruction.dst[1].field = OperandField::VccLo;
         m_instruction.dst[1].type = ScalarType::Uint64;
         m_instruction.dst[1].code = static_cast<u32>(OperandField::VccLo);
@@ -601,28 +835,7 @@ void GcnDecodeContext::decodeInstructionVOP3(uint64_t hexInstruction) {
     u32 src1 = bit::extract(hexInstruction, 49, 41);
     u32 src2 = bit::extract(hexInstruction, 58, 50);
 
-    if (op >= static_cast<u32>(OpcodeVOP3::V_CMP_F_F32) &&
-        op <= static_cast<u32>(OpcodeVOP3::V_CMPX_T_U64)) {
-        // Map from VOP3 to VOPC
-        u32 vopcOp = op - static_cast<u32>(OpMapVOP3VOPX::VOP3_TO_VOPC);
-        m_instruction.opcode =
-            static_cast<Opcode>(vopcOp + static_cast<u32>(OpcodeMap::OP_MAP_VOPC));
-    } else if (op >= static_cast<u32>(OpcodeVOP3::V_CNDMASK_B32) &&
-               op <= static_cast<u32>(OpcodeVOP3::V_CVT_PK_I16_I32)) {
-        // Map from VOP3 to VOP2
-        u32 vop2Op = op - static_cast<u32>(OpMapVOP3VOPX::VOP3_TO_VOP2);
-        m_instruction.opcode =
-            static_cast<Opcode>(vop2Op + static_cast<u32>(OpcodeMap::OP_MAP_VOP2));
-    } else if (op >= static_cast<u32>(OpcodeVOP3::V_NOP) &&
-               op <= static_cast<u32>(OpcodeVOP3::V_MOVRELSD_B32)) {
-        // Map from VOP3 to VOP1
-        u32 vop1Op = op - static_cast<u32>(OpMapVOP3VOPX::VOP3_TO_VOP1);
-        m_instruction.opcode =
-            static_cast<Opcode>(vop1Op + static_cast<u32>(OpcodeMap::OP_MAP_VOP1));
-    } else {
-        // VOP3 encoding, do not map.
-        m_instruction.opcode = static_cast<Opcode>(op + static_cast<u32>(OpcodeMap::OP_MAP_VOP3));
-    }
+    m_instruction.opcode = MapVop3Opcode(op);
 
     m_instruction.src[0].field = getOperandField(src0);
     m_instruction.src[0].code =
@@ -637,7 +850,7 @@ void GcnDecodeContext::decodeInstructionVOP3(uint64_t hexInstruction) {
     m_instruction.dst[0].code = vdst;
 
     OpcodeVOP3 vop3Op = static_cast<OpcodeVOP3>(op);
-    if (IsVop3BEncoding(m_instruction.opcode)) {
+    if (GetInstInfo(InstEncoding::VOP3, m_instruction.opcode).is_vop3b) {
         m_instruction.dst[1].field = OperandField::ScalarGPR;
         m_instruction.dst[1].type = ScalarType::Uint64;
         m_instruction.dst[1].code = sdst;
@@ -1039,7 +1252,7 @@ void GcnDecodeContext::decodeInstructionDS(uint64_t hexInstruction) {
 
     m_instruction.control.ds = *reinterpret_cast<InstControlDS*>(&hexInstruction);
 
-    auto instFormat = InstructionFormat(InstEncoding::DS, (u32)op);
+    const InstFormat& instFormat = GetInstInfo(InstEncoding::DS, m_instruction.opcode).format;
 
     m_instruction.control.ds.dual =
         op == OpcodeDS::DS_WRITE2_B32 || op == OpcodeDS::DS_WRXCHG2_RTN_B32 ||
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <span>
+#include <vector>
 #include "frontend/instruction.h"
 
 namespace Shader::Gcn {
@@ -14,16 +16,84 @@ struct InstFormat {
     u32 dst_count = 0;
     ScalarType src_type = ScalarType::Undefined;
     ScalarType dst_type = ScalarType::Undefined;
+
+    bool operator==(const InstFormat&) const = default;
+};
+
+struct InstInfo {
+    InstFormat format;
+    InstEncoding encoding = InstEncoding::ILLEGAL;
+    u8 length = 0; ///< Encoding length in bytes, zero for opcodes the ISA does not define.
+    bool has_literal = false; ///< A literal dword always follows the encoding.
+    bool is_vop3b = false;    ///< Writes an additional scalar destination.
 };
 
+struct EncodingInfo {
+    InstEncoding encoding = InstEncoding::ILLEGAL;
+    u32 length = 0;
+};
+
+/// Returns the encoding and its length in bytes of the instruction starting with token.
+/// Classification is a single lookup on the top bits of the token.
+EncodingInfo GetEncodingInfo(u32 token);
+
 InstEncoding GetInstructionEncoding(u32 token);
 
+/// Classifies the token by testing each encoding mask in turn.
+/// Reference implementation for GetInstructionEncoding.
+InstEncoding ClassifyInstructionEncoding(u32 token);
+
 u32 GetEncodingLength(InstEncoding encoding);
 
-InstFormat InstructionFormat(InstEncoding encoding, u32 opcode);
+/// Classifies every token in tokens as if it started an instruction, writing the result to the
+/// matching out slot. Uses AVX2 to classify eight tokens at once when the CPU supports it.
+void ClassifyTokens(std::span<const u32> tokens, std::span<EncodingInfo> out);
+
+/// Returns true if ClassifyTokens runs the vectorized path on this CPU.
+bool IsVectorClassifySupported();
+
+/// Returns the metadata of opcode decoded from the given encoding with a single table load.
+/// VOPC, VOP2 and VOP1 opcodes promoted to VOP3 have their own entries.
+const InstInfo& GetInstInfo(InstEncoding encoding, Opcode opcode);
+
+/// Returns the metadata of opcode in its native encoding, or in its VOP3 form if vop3 is set.
+const InstInfo& GetInstInfo(Opcode opcode, bool vop3);
+
+/// Maps a VOP3 encoding opcode to its unified opcode.
+/// Opcodes that also exist in the VOPC, VOP2 or VOP1 encodings resolve to that opcode.
+constexpr Opcode MapVop3Opcode(u32 op) {
+    if (op >= static_cast<u32>(OpcodeVOP3::V_CMP_F_F32) &&
+        op <= static_cast<u32>(OpcodeVOP3::V_CMPX_T_U64)) {
+        // Map from VOP3 to VOPC
+        const u32 vopcOp = op - static_cast<u32>(OpMapVOP3VOPX::VOP3_TO_VOPC);
+        return static_cast<Opcode>(vopcOp + static_cast<u32>(OpcodeMap::OP_MAP_VOPC));
+    }
+    if (op >= static_cast<u32>(OpcodeVOP3::V_CNDMASK_B32) &&
+        op <= static_cast<u32>(OpcodeVOP3::V_CVT_PK_I16_I32)) {
+        // Map from VOP3 to VOP2
+        const u32 vop2Op = op - static_cast<u32>(OpMapVOP3VOPX::VOP3_TO_VOP2);
+        return static_cast<Opcode>(vop2Op + static_cast<u32>(OpcodeMap::OP_MAP_VOP2));
+    }
+    if (op >= static_cast<u32>(OpcodeVOP3::V_NOP) &&
+        op <= static_cast<u32>(OpcodeVOP3::V_MOVRELSD_B32)) {
+        // Map from VOP3 to VOP1
+        const u32 vop1Op = op - static_cast<u32>(OpMapVOP3VOPX::VOP3_TO_VOP1);
+        return static_cast<Opcode>(vop1Op + static_cast<u32>(OpcodeMap::OP_MAP_VOP1));
+    }
+    // VOP3 encoding, do not map.
+    return static_cast<Opcode>(op + static_cast<u32>(OpcodeMap::OP_MAP_VOP3));
+}
 
 Opcode DecodeOpcode(u32 token);
 
+/// Returns the size in dwords of the instruction starting with token, including its literal
+/// constant. Zero if the token does not start a valid instruction.
+u32 GetInstructionSize(u32 token);
+
+/// Computes the dword offset of every instruction in code without decoding them.
+/// A trailing instruction that does not fit in code is dropped.
+std::vector<u32> ScanInstructionOffsets(std::span<const u32> code);
+
 class GcnCodeSlice {
 public:
     GcnCodeSlice(const u32* ptr, const u32* end) : m_ptr(ptr), m_end(end) {}
@@ -53,23 +123,69 @@ private:
     const u32* m_end{};
 };
 
+struct DecodeResult {
+    size_t num_insts;  ///< Number of instructions written to the output.
+    size_t num_dwords; ///< Number of code dwords consumed.
+};
+
+/// Decodes instructions from code directly into out, stopping when either one is exhausted.
+/// An instruction that does not fit in code is left undecoded and its dwords unconsumed.
+/// Keeps no state between calls, so it is safe to call from multiple threads at once.
+DecodeResult DecodeRange(std::span<const u32> code, std::span<GcnInst> out);
+
+/// Decodes the instructions at the offsets computed by ScanInstructionOffsets or
+/// ScanReachableOffsets into the matching out slots. Large shaders are split into chunks that
+/// are decoded on separate threads. Throws InvalidArgument on an illegal instruction.
+void DecodeParallel(std::span<const u32> code, std::span<const u32> offsets,
+                    std::span<GcnInst> out);
+
+/// Instruction with all operands expanded, filled by the decoder and then packed into a GcnInst.
+struct DecodedInst {
+    Opcode opcode;
+    InstEncoding encoding;
+    InstControl control;
+    u32 length;
+    u32 src_count;
+    u32 dst_count;
+    std::array<InstOperand, GcnMaxSrcCount> src;
+    std::array<InstOperand, GcnMaxDstCount> dst;
+};
+
+/// Instructions reachable from the entry point of a shader.
+struct ReachableCode {
+    std::vector<GcnInst> insts; ///< Reachable instructions in address order.
+    std::vector<u32> pcs;       ///< Byte address of each instruction.
+    u32 end;                    ///< Byte address one past the last reachable instruction.
+};
+
+/// Computes the sorted dword offsets of the instructions reachable from pc 0 by following
+/// branches, without decoding them. A path stops at S_ENDPGM or an unconditional branch, so
+/// trailing padding and the shader binary footer are never touched.
+std::vector<u32> ScanReachableOffsets(std::span<const u32> code);
+
+/// Decodes the instructions found by ScanReachableOffsets with DecodeParallel.
+/// Throws InvalidArgument if a reachable instruction is illegal or truncated.
+ReachableCode DecodeReachable(std::span<const u32> code);
+
 class GcnDecodeContext {
 public:
-    GcnInst decodeInstruction(GcnCodeSlice& code);
+    explicit GcnDecodeContext(GcnInst& instruction) : m_output{instruction} {}
+
+    /// Decodes the instruction at the start of code into the bound instruction
+    /// and advances code past it.
+    void decodeInstruction(GcnCodeSlice& code);
 
 private:
-    uint32_t getEncodingLength(InstEncoding encoding);
-    uint32_t getOpMapOffset(InstEncoding encoding);
-    uint32_t mapEncodingOp(InstEncoding encoding, Opcode opcode);
-    void updateInstructionMeta(InstEncoding encoding);
+    void updateInstructionMeta(InstEncoding encoding, const InstInfo& info);
     uint32_t getMimgModifier(Opcode opcode);
     void repairOperandType();
+    void packInstruction();
 
     OperandField getOperandField(uint32_t code);
 
     void decodeInstruction32(InstEncoding encoding, GcnCodeSlice& code);
     void decodeInstruction64(InstEncoding encoding, GcnCodeSlice& code);
-    void decodeLiteralConstant(InstEncoding encoding, GcnCodeSlice& code);
+    void decodeLiteralConstant(const InstInfo& info, GcnCodeSlice& code);
 
     // 32 bits encodings
     void decodeInstructionSOP1(uint32_t hexInstruction);
@@ -91,7 +207,8 @@ private:
     void decodeInstructionEXP(uint64_t hexInstruction);
 
 private:
-    GcnInst m_instruction;
+    DecodedInst m_instruction{};
+    GcnInst& m_output;
 };
 
 } // namespace Shader::Gcn
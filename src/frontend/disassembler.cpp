@@ -0,0 +1,315 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iterator>
+#include "common/assert.h"
+#include "frontend/decode.h"
+#include "frontend/disassembler.h"
+
+namespace Shader::Gcn {
+
+namespace {
+
+using Buffer = fmt::memory_buffer;
+
+template <typename... Args>
+void Append(Buffer& out, fmt::format_string<Args...> format, Args... args) {
+    fmt::vformat_to(std::back_inserter(out), format, fmt::make_format_args(args...));
+}
+
+void Append(Buffer& out, std::string_view text) {
+    out.append(text);
+}
+
+/// Register range of an operand. The first register is in units of scale registers.
+struct RegisterRange {
+    u32 scale = 1;
+    u32 count = 1;
+};
+
+bool Is64Bit(ScalarType type) {
+    return type == ScalarType::Uint64 || type == ScalarType::Sint64 ||
+           type == ScalarType::Float64;
+}
+
+/// Resource and address operands of memory encodings hold aligned register groups.
+RegisterRange GetRegisterRange(const GcnInst& inst, InstEncoding encoding, bool is_dst,
+                               u32 index, const InstOperand& operand) {
+    switch (encoding) {
+    case InstEncoding::SMRD:
+        if (is_dst) {
+            return {1, std::max<u32>(inst.control.smrd.count, 1)};
+        }
+        if (index == 0) {
+            const bool is_buffer = inst.opcode >= Opcode::S_BUFFER_LOAD_DWORD &&
+                                   inst.opcode <= Opcode::S_BUFFER_LOAD_DWORDX16;
+            return {2, is_buffer ? 4U : 2U};
+        }
+        break;
+    case InstEncoding::MUBUF:
+    case InstEncoding::MTBUF:
+        if (index == 1) {
+            const u32 count = encoding == InstEncoding::MUBUF ? inst.control.mubuf.count
+                                                              : inst.control.mtbuf.count;
+            return {1, std::max<u32>(count, 1)};
+        }
+        if (index == 2) {
+            return {4, 4};
+        }
+        break;
+    case InstEncoding::MIMG:
+        if (is_dst) {
+            return {1, std::max<u32>(std::popcount(inst.control.mimg.dmask), 1)};
+        }
+        if (index == 2) {
+            return {4, inst.control.mimg.r128 ? 4U : 8U};
+        }
+        if (index == 3) {
+            return {4, 4};
+        }
+        break;
+    default:
+        break;
+    }
+    return {1, Is64Bit(operand.type) ? 2U : 1U};
+}
+
+void FormatRegister(Buffer& out, char prefix, u32 code, RegisterRange range) {
+    const u32 first = code * range.scale;
+    if (range.count == 1) {
+        Append(out, "{}{}", prefix, first);
+    } else {
+        Append(out, "{}[{}:{}]", prefix, first, first + range.count - 1);
+    }
+}
+
+std::string_view ConstFloatName(OperandField field) {
+    switch (field) {
+    case OperandField::ConstFloatPos_0_5:
+        return "0.5";
+    case OperandField::ConstFloatNeg_0_5:
+        return "-0.5";
+    case OperandField::ConstFloatPos_1_0:
+        return "1.0";
+    case OperandField::ConstFloatNeg_1_0:
+        return "-1.0";
+    case OperandField::ConstFloatPos_2_0:
+        return "2.0";
+    case OperandField::ConstFloatNeg_2_0:
+        return "-2.0";
+    case OperandField::ConstFloatPos_4_0:
+        return "4.0";
+    case OperandField::ConstFloatNeg_4_0:
+        return "-4.0";
+    default:
+        return {};
+    }
+}
+
+void FormatOperand(Buffer& out, const InstOperand& operand, RegisterRange range) {
+    const bool is_64bit = range.count == 2;
+    if (operand.input_modifier.neg) {
+        out.push_back('-');
+    }
+    if (operand.input_modifier.abs) {
+        out.push_back('|');
+    }
+    switch (operand.field) {
+    case OperandField::ScalarGPR:
+        FormatRegister(out, 's', operand.code, range);
+        break;
+    case OperandField::VectorGPR:
+        FormatRegister(out, 'v', operand.code, range);
+        break;
+    case OperandField::VccLo:
+        Append(out, is_64bit ? "vcc" : "vcc_lo");
+        break;
+    case OperandField::VccHi:
+        Append(out, "vcc_hi");
+        break;
+    case OperandField::M0:
+        Append(out, "m0");
+        break;
+    case OperandField::ExecLo:
+        Append(out, is_64bit ? "exec" : "exec_lo");
+        break;
+    case OperandField::ExecHi:
+        Append(out, "exec_hi");
+        break;
+    case OperandField::ConstZero:
+        out.push_back('0');
+        break;
+    case OperandField::SignedConstIntPos:
+        Append(out, "{}", operand.code - SignedConstIntPosMin + 1);
+        break;
+    case OperandField::SignedConstIntNeg:
+        Append(out, "-{}", operand.code - SignedConstIntNegMin + 1);
+        break;
+    case OperandField::VccZ:
+        Append(out, "vccz");
+        break;
+    case OperandField::ExecZ:
+        Append(out, "execz");
+        break;
+    case OperandField::Scc:
+        Append(out, "scc");
+        break;
+    case OperandField::LdsDirect:
+        Append(out, "lds_direct");
+        break;
+    case OperandField::LiteralConst:
+        Append(out, "{:#x}", operand.code);
+        break;
+    default:
+        if (const auto name = ConstFloatName(operand.field); !name.empty()) {
+            Append(out, name);
+        } else {
+            // Special registers the decoder does not name, print the raw operand code.
+            Append(out, "src_{}", operand.code);
+        }
+        break;
+    }
+    if (operand.input_modifier.abs) {
+        out.push_back('|');
+    }
+}
+
+void FormatFlag(Buffer& out, bool value, std::string_view name) {
+    if (value) {
+        out.push_back(' ');
+        Append(out, name);
+    }
+}
+
+void FormatControl(Buffer& out, const GcnInst& inst, InstEncoding encoding, u32 pc) {
+    const InstControl& control = inst.control;
+    switch (encoding) {
+    case InstEncoding::SOPP:
+        if (inst.IsUnconditionalBranch() || inst.IsConditionalBranch() ||
+            inst.opcode == Opcode::S_CBRANCH_CDBGSYS ||
+            inst.opcode == Opcode::S_CBRANCH_CDBGUSER ||
+            inst.opcode == Opcode::S_CBRANCH_CDBGSYS_OR_USER ||
+            inst.opcode == Opcode::S_CBRANCH_CDBGSYS_AND_USER) {
+            Append(out, " {:#x}", inst.BranchTarget(pc));
+        } else if (inst.opcode == Opcode::S_WAITCNT) {
+            const u32 simm = control.sopp.simm;
+            Append(out, " vmcnt({}) expcnt({}) lgkmcnt({})", simm & 0xF, (simm >> 4) & 0x7,
+                   (simm >> 8) & 0x1F);
+        } else if (control.sopp.simm != 0) {
+            Append(out, " {:#x}", control.sopp.simm.Value());
+        }
+        break;
+    case InstEncoding::SOPK:
+        Append(out, " simm:{:#x}", control.sopk.simm.Value());
+        break;
+    case InstEncoding::SMRD:
+        if (control.smrd.imm) {
+            Append(out, " offset:{:#x}", control.smrd.offset);
+        }
+        break;
+    case InstEncoding::VOP3: {
+        const InstOperand dst = inst.Dst(0);
+        FormatFlag(out, dst.output_modifier.clamp, "clamp");
+        if (!std::isnan(dst.output_modifier.multiplier)) {
+            if (dst.output_modifier.multiplier < 1.0f) {
+                Append(out, " div:2");
+            } else {
+                Append(out, " mul:{}", static_cast<u32>(dst.output_modifier.multiplier));
+            }
+        }
+        break;
+    }
+    case InstEncoding::MUBUF:
+        Append(out, " offset:{}", control.mubuf.offset);
+        FormatFlag(out, control.mubuf.offen, "offen");
+        FormatFlag(out, control.mubuf.idxen, "idxen");
+        FormatFlag(out, control.mubuf.glc, "glc");
+        FormatFlag(out, control.mubuf.slc, "slc");
+        FormatFlag(out, control.mubuf.lds, "lds");
+        FormatFlag(out, control.mubuf.tfe, "tfe");
+        break;
+    case InstEncoding::MTBUF:
+        Append(out, " offset:{} dfmt:{} nfmt:{}", control.mtbuf.offset, control.mtbuf.dfmt,
+               control.mtbuf.nfmt);
+        FormatFlag(out, control.mtbuf.offen, "offen");
+        FormatFlag(out, control.mtbuf.idxen, "idxen");
+        FormatFlag(out, control.mtbuf.glc, "glc");
+        FormatFlag(out, control.mtbuf.slc, "slc");
+        FormatFlag(out, control.mtbuf.tfe, "tfe");
+        break;
+    case InstEncoding::MIMG:
+        Append(out, " dmask:{:#x}", control.mimg.dmask);
+        FormatFlag(out, control.mimg.unrm, "unorm");
+        FormatFlag(out, control.mimg.glc, "glc");
+        FormatFlag(out, control.mimg.slc, "slc");
+        FormatFlag(out, control.mimg.da, "da");
+        FormatFlag(out, control.mimg.r128, "r128");
+        FormatFlag(out, control.mimg.tfe, "tfe");
+        FormatFlag(out, control.mimg.lwe, "lwe");
+        break;
+    case InstEncoding::DS:
+        Append(out, " offset0:{} offset1:{}", control.ds.offset0, control.ds.offset1);
+        FormatFlag(out, control.ds.gds, "gds");
+        break;
+    case InstEncoding::VINTRP:
+        Append(out, " attr{}.{}", control.vintrp.attr, "xyzw"[control.vintrp.chan]);
+        break;
+    case InstEncoding::EXP:
+        Append(out, " target:{} en:{:#x}", control.exp.target, control.exp.en);
+        FormatFlag(out, control.exp.compr, "compr");
+        FormatFlag(out, control.exp.done, "done");
+        FormatFlag(out, control.exp.vm, "vm");
+        break;
+    default:
+        break;
+    }
+}
+
+} // Anonymous namespace
+
+void FormatInstruction(fmt::memory_buffer& out, const GcnInst& inst, u32 pc) {
+    const InstEncoding encoding = inst.Encoding();
+    Append(out, NameOf(inst.opcode));
+    if (inst.is_vop3 && inst.opcode < static_cast<Opcode>(OpcodeMap::OP_MAP_VOP3)) {
+        // Promoted from VOPC, VOP2 or VOP1.
+        Append(out, "_e64");
+    }
+
+    bool first = true;
+    const auto format_operand = [&](const InstOperand& operand, bool is_dst, u32 index) {
+        if (operand.field == OperandField::Undefined) {
+            return;
+        }
+        Append(out, first ? " " : ", ");
+        first = false;
+        FormatOperand(out, operand, GetRegisterRange(inst, encoding, is_dst, index, operand));
+    };
+    for (u32 i = 0; i < inst.dst_count; i++) {
+        format_operand(inst.Dst(i), true, i);
+    }
+    for (u32 i = 0; i < inst.src_count; i++) {
+        format_operand(inst.Src(i), false, i);
+    }
+    FormatControl(out, inst, encoding, pc);
+}
+
+void Disassemble(fmt::memory_buffer& out, std::span<const GcnInst> inst_list,
+                 std::span<const u32> inst_pcs) {
+    ASSERT(inst_pcs.empty() || inst_pcs.size() == inst_list.size());
+    u32 pc = 0;
+    for (size_t i = 0; i < inst_list.size(); i++) {
+        if (!inst_pcs.empty()) {
+            pc = inst_pcs[i];
+        }
+        const GcnInst& inst = inst_list[i];
+        Append(out, "{:08x}: ", pc);
+        FormatInstruction(out, inst, pc);
+        out.push_back('\n');
+        pc += inst.length;
+    }
+}
+
+} // namespace Shader::Gcn
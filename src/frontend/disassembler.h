@@ -0,0 +1,23 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+#include <fmt/format.h>
+#include "frontend/instruction.h"
+
+namespace Shader::Gcn {
+
+/// Appends the text of inst located at byte address pc to out, without a trailing newline.
+/// Operands are printed as decoded, destinations first, followed by the control fields of
+/// the encoding. Nothing is allocated besides the growth of out.
+void FormatInstruction(fmt::memory_buffer& out, const GcnInst& inst, u32 pc);
+
+/// Appends one line per instruction to out, prefixed with its byte address.
+/// inst_pcs holds the byte address of each instruction. When empty the instructions
+/// are assumed to be contiguous from address zero.
+void Disassemble(fmt::memory_buffer& out, std::span<const GcnInst> inst_list,
+                 std::span<const u32> inst_pcs = {});
+
+} // namespace Shader::Gcn
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <array>
 #include "common/assert.h"
 #include "frontend/decode.h"
 
@@ -134,7 +136,7 @@ constexpr std::array<InstFormat, 45> InstructionFormatSOP2 = { {
         ScalarType::Sint64, ScalarType::Sint64 },
     // 43 = S_CBRANCH_G_FORK
     { InstClass::ScalarProgFlow, InstCategory::FlowControl, 2, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint64, ScalarType::Uint64 },
     // 44 = S_ABSDIFF_I32
     { InstClass::ScalarAbs, InstCategory::ScalarALU, 2, 1,
         ScalarType::Sint32, ScalarType::Sint32 },
@@ -192,14 +194,16 @@ constexpr std::array<InstFormat, 22> InstructionFormatSOPK = { {
         ScalarType::Sint32, ScalarType::Sint32 },
     // 17 = S_CBRANCH_I_FORK
     { InstClass::ScalarProgFlow, InstCategory::FlowControl, 0, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint64, ScalarType::Uint64 },
     // 18 = S_GETREG_B32
     { InstClass::ScalarProgFlow, InstCategory::FlowControl, 0, 1,
         ScalarType::Uint32, ScalarType::Uint32 },
     // 19 = S_SETREG_B32
     { InstClass::ScalarRegAccess, InstCategory::FlowControl, 0, 1,
         ScalarType::Uint32, ScalarType::Uint32 },
-    {},
+    // 20 = S_GETREG_REGRD_B32
+    { InstClass::ScalarRegAccess, InstCategory::ScalarALU, 0, 1,
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 21 = S_SETREIMM32_B32
     { InstClass::ScalarRegAccess, InstCategory::FlowControl, 0, 1,
         ScalarType::Uint32, ScalarType::Uint32 },
@@ -350,8 +354,10 @@ constexpr std::array<InstFormat, 54> InstructionFormatSOP1 = { {
         ScalarType::Uint64, ScalarType::Uint64 },
     // 50 = S_CBRANCH_JOIN
     { InstClass::ScalarProgFlow, InstCategory::FlowControl, 1, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
-    {},
+        ScalarType::Uint32, ScalarType::Uint32 },
+    // 51 = S_MOV_REGRD_B32
+    { InstClass::ScalarMov, InstCategory::ScalarALU, 1, 1,
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 52 = S_ABS_I32
     { InstClass::ScalarAbs, InstCategory::ScalarALU, 1, 1,
         ScalarType::Sint32, ScalarType::Sint32 },
@@ -411,7 +417,7 @@ constexpr std::array<InstFormat, 17> InstructionFormatSOPC = { {
         ScalarType::Uint64, ScalarType::Uint64 },
     // 16 = S_SETVSKIP
     { InstClass::ScalarProgFlow, InstCategory::FlowControl, 2, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
 } };
 
 constexpr std::array<InstFormat, 27> InstructionFormatSOPP = { {
@@ -446,7 +452,9 @@ constexpr std::array<InstFormat, 27> InstructionFormatSOPP = { {
     // 10 = S_BARRIER
     { InstClass::ScalarSync, InstCategory::FlowControl, 0, 1,
         ScalarType::Any, ScalarType::Any },
-    {},
+    // 11 = S_SETKILL
+    { InstClass::ScalarProgFlow, InstCategory::FlowControl, 0, 1,
+        ScalarType::Any, ScalarType::Any },
     // 12 = S_WAITCNT
     { InstClass::ScalarSync, InstCategory::FlowControl, 0, 1,
         ScalarType::Any, ScalarType::Any },
@@ -546,13 +554,13 @@ constexpr std::array<InstFormat, 32> InstructionFormatSMRD = { {
     {},
     // 29 = S_DCACHE_INV_VOL
     { InstClass::ScalarMemUt, InstCategory::ScalarMemory, 1, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Any, ScalarType::Any },
     // 30 = S_MEMTIME
     { InstClass::ScalarMemUt, InstCategory::ScalarMemory, 1, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint64, ScalarType::Uint64 },
     // 31 = S_DCACHE_INV
     { InstClass::ScalarMemUt, InstCategory::ScalarMemory, 1, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Any, ScalarType::Any },
 } };
 
 constexpr std::array<InstFormat, 50> InstructionFormatVOP2 = { {
@@ -1699,7 +1707,7 @@ constexpr std::array<InstFormat, 455> InstructionFormatVOP3 = { {
     {},
     // 384 = V_NOP
     { InstClass::VectorMisc, InstCategory::VectorALU, 0, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Any, ScalarType::Any },
     // 385 = V_MOV_B32
     { InstClass::VectorRegMov, InstCategory::VectorALU, 1, 1,
         ScalarType::Uint32, ScalarType::Uint32 },
@@ -1750,26 +1758,34 @@ constexpr std::array<InstFormat, 455> InstructionFormatVOP3 = { {
         ScalarType::Float32, ScalarType::Float64 },
     // 401 = V_CVT_F32_UBYTE0
     { InstClass::VectorConv, InstCategory::VectorALU, 1, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Float32 },
     // 402 = V_CVT_F32_UBYTE1
     { InstClass::VectorConv, InstCategory::VectorALU, 1, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Float32 },
     // 403 = V_CVT_F32_UBYTE2
     { InstClass::VectorConv, InstCategory::VectorALU, 1, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Float32 },
     // 404 = V_CVT_F32_UBYTE3
     { InstClass::VectorConv, InstCategory::VectorALU, 1, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Float32 },
     // 405 = V_CVT_U32_F64
     { InstClass::VectorConv, InstCategory::VectorALU, 1, 1,
         ScalarType::Float64, ScalarType::Uint32 },
     // 406 = V_CVT_F64_U32
     { InstClass::VectorConv, InstCategory::VectorALU, 1, 1,
         ScalarType::Uint32, ScalarType::Float64 },
-    {},
-    {},
-    {},
-    {},
+    // 407 = V_TRUNC_F64
+    { InstClass::VectorFpRound64, InstCategory::VectorALU, 1, 1,
+        ScalarType::Float64, ScalarType::Float64 },
+    // 408 = V_CEIL_F64
+    { InstClass::VectorFpRound64, InstCategory::VectorALU, 1, 1,
+        ScalarType::Float64, ScalarType::Float64 },
+    // 409 = V_RNDNE_F64
+    { InstClass::VectorFpRound64, InstCategory::VectorALU, 1, 1,
+        ScalarType::Float64, ScalarType::Float64 },
+    // 410 = V_FLOOR_F64
+    { InstClass::VectorFpRound64, InstCategory::VectorALU, 1, 1,
+        ScalarType::Float64, ScalarType::Float64 },
     {},
     {},
     {},
@@ -1876,7 +1892,7 @@ constexpr std::array<InstFormat, 455> InstructionFormatVOP3 = { {
         ScalarType::Float32, ScalarType::Float32 },
     // 449 = V_CLREXCP
     { InstClass::Undefined, InstCategory::Undefined, 0, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Any, ScalarType::Any },
     // 450 = V_MOVRELD_B32
     { InstClass::VectorMovRel, InstCategory::VectorALU, 1, 1,
         ScalarType::Uint32, ScalarType::Uint32 },
@@ -1886,14 +1902,18 @@ constexpr std::array<InstFormat, 455> InstructionFormatVOP3 = { {
     // 452 = V_MOVRELSD_B32
     { InstClass::VectorMovRel, InstCategory::VectorALU, 1, 1,
         ScalarType::Uint32, ScalarType::Uint32 },
-    {},
-    {},
+    // 453 = V_LOG_LEGACY_F32
+    { InstClass::VectorFpTran32, InstCategory::VectorALU, 1, 1,
+        ScalarType::Float32, ScalarType::Float32 },
+    // 454 = V_EXP_LEGACY_F32
+    { InstClass::VectorFpTran32, InstCategory::VectorALU, 1, 1,
+        ScalarType::Float32, ScalarType::Float32 },
 } };
 
 constexpr std::array<InstFormat, 71> InstructionFormatVOP1 = { {
     // 0 = V_NOP
     { InstClass::VectorMisc, InstCategory::VectorALU, 0, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Any, ScalarType::Any },
     // 1 = V_MOV_B32
     { InstClass::VectorRegMov, InstCategory::VectorALU, 1, 1,
         ScalarType::Uint32, ScalarType::Uint32 },
@@ -1944,26 +1964,34 @@ constexpr std::array<InstFormat, 71> InstructionFormatVOP1 = { {
         ScalarType::Float32, ScalarType::Float64 },
     // 17 = V_CVT_F32_UBYTE0
     { InstClass::VectorConv, InstCategory::VectorALU, 1, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Float32 },
     // 18 = V_CVT_F32_UBYTE1
     { InstClass::VectorConv, InstCategory::VectorALU, 1, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Float32 },
     // 19 = V_CVT_F32_UBYTE2
     { InstClass::VectorConv, InstCategory::VectorALU, 1, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Float32 },
     // 20 = V_CVT_F32_UBYTE3
     { InstClass::VectorConv, InstCategory::VectorALU, 1, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Float32 },
     // 21 = V_CVT_U32_F64
     { InstClass::VectorConv, InstCategory::VectorALU, 1, 1,
         ScalarType::Float64, ScalarType::Uint32 },
     // 22 = V_CVT_F64_U32
     { InstClass::VectorConv, InstCategory::VectorALU, 1, 1,
         ScalarType::Uint32, ScalarType::Float64 },
-    {},
-    {},
-    {},
-    {},
+    // 23 = V_TRUNC_F64
+    { InstClass::VectorFpRound64, InstCategory::VectorALU, 1, 1,
+        ScalarType::Float64, ScalarType::Float64 },
+    // 24 = V_CEIL_F64
+    { InstClass::VectorFpRound64, InstCategory::VectorALU, 1, 1,
+        ScalarType::Float64, ScalarType::Float64 },
+    // 25 = V_RNDNE_F64
+    { InstClass::VectorFpRound64, InstCategory::VectorALU, 1, 1,
+        ScalarType::Float64, ScalarType::Float64 },
+    // 26 = V_FLOOR_F64
+    { InstClass::VectorFpRound64, InstCategory::VectorALU, 1, 1,
+        ScalarType::Float64, ScalarType::Float64 },
     {},
     {},
     {},
@@ -2070,7 +2098,7 @@ constexpr std::array<InstFormat, 71> InstructionFormatVOP1 = { {
         ScalarType::Float32, ScalarType::Float32 },
     // 65 = V_CLREXCP
     { InstClass::Undefined, InstCategory::Undefined, 0, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Any, ScalarType::Any },
     // 66 = V_MOVRELD_B32
     { InstClass::VectorMovRel, InstCategory::VectorALU, 1, 1,
         ScalarType::Uint32, ScalarType::Uint32 },
@@ -2080,8 +2108,12 @@ constexpr std::array<InstFormat, 71> InstructionFormatVOP1 = { {
     // 68 = V_MOVRELSD_B32
     { InstClass::VectorMovRel, InstCategory::VectorALU, 1, 1,
         ScalarType::Uint32, ScalarType::Uint32 },
-    {},
-    {},
+    // 69 = V_LOG_LEGACY_F32
+    { InstClass::VectorFpTran32, InstCategory::VectorALU, 1, 1,
+        ScalarType::Float32, ScalarType::Float32 },
+    // 70 = V_EXP_LEGACY_F32
+    { InstClass::VectorFpTran32, InstCategory::VectorALU, 1, 1,
+        ScalarType::Float32, ScalarType::Float32 },
 } };
 
 constexpr std::array<InstFormat, 248> InstructionFormatVOPC = { {
@@ -2802,28 +2834,28 @@ constexpr std::array<InstFormat, 256> InstructionFormatDS = { {
         ScalarType::Float32, ScalarType::Float32 },
     // 20 = DS_NOP
     { InstClass::DsDataShareMisc, InstCategory::DataShare, 3, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     {},
     {},
     {},
     // 24 = DS_GWS_SEMA_RELEASE_ALL
     { InstClass::GdsSync, InstCategory::DataShare, 3, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 25 = DS_GWS_INIT
     { InstClass::GdsSync, InstCategory::DataShare, 3, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 26 = DS_GWS_SEMA_V
     { InstClass::GdsSync, InstCategory::DataShare, 3, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 27 = DS_GWS_SEMA_BR
     { InstClass::GdsSync, InstCategory::DataShare, 3, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 28 = DS_GWS_SEMA_P
     { InstClass::GdsSync, InstCategory::DataShare, 3, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 29 = DS_GWS_BARRIER
     { InstClass::ScalarSync, InstCategory::FlowControl, 3, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 30 = DS_WRITE_B8
     { InstClass::DsIdxWr, InstCategory::DataShare, 3, 1,
         ScalarType::Uint32, ScalarType::Uint32 },
@@ -2919,13 +2951,13 @@ constexpr std::array<InstFormat, 256> InstructionFormatDS = { {
         ScalarType::Uint32, ScalarType::Uint32 },
     // 61 = DS_CONSUME
     { InstClass::DsAppendCon, InstCategory::DataShare, 3, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 62 = DS_APPEND
     { InstClass::DsAppendCon, InstCategory::DataShare, 3, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 63 = DS_ORDERED_COUNT
     { InstClass::GdsOrdCnt, InstCategory::DataShare, 3, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 64 = DS_ADD_U64
     { InstClass::DsAtomicArith64, InstCategory::DataShare, 3, 1,
         ScalarType::Uint64, ScalarType::Uint64 },
@@ -3234,10 +3266,10 @@ constexpr std::array<InstFormat, 256> InstructionFormatDS = { {
     {},
     // 222 = DS_WRITE_B96
     { InstClass::Undefined, InstCategory::Undefined, 3, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 223 = DS_WRITE_B128
     { InstClass::Undefined, InstCategory::Undefined, 3, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     {},
     {},
     {},
@@ -3269,13 +3301,13 @@ constexpr std::array<InstFormat, 256> InstructionFormatDS = { {
     {},
     // 253 = DS_CONDXCHG32_RTN_B128
     { InstClass::Undefined, InstCategory::Undefined, 3, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 254 = DS_READ_B96
     { InstClass::Undefined, InstCategory::Undefined, 3, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 255 = DS_READ_B128
     { InstClass::Undefined, InstCategory::Undefined, 3, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
 } };
 
 constexpr std::array<InstFormat, 114> InstructionFormatMUBUF = { {
@@ -3501,10 +3533,10 @@ constexpr std::array<InstFormat, 114> InstructionFormatMUBUF = { {
     {},
     // 112 = BUFFER_WBINVL1_SC
     { InstClass::VectorMemL1Cache, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Any, ScalarType::Any },
     // 113 = BUFFER_WBINVL1
     { InstClass::VectorMemL1Cache, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Any, ScalarType::Any },
 } };
 
 constexpr std::array<InstFormat, 8> InstructionFormatMTBUF = { {
@@ -3574,53 +3606,53 @@ constexpr std::array<InstFormat, 112> InstructionFormatMIMG = { {
         ScalarType::Uint32, ScalarType::Uint32 },
     // 15 = IMAGE_ATOMIC_SWAP
     { InstClass::VectorMemImgNoSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 16 = IMAGE_ATOMIC_CMPSWAP
     { InstClass::VectorMemImgNoSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 17 = IMAGE_ATOMIC_ADD
     { InstClass::VectorMemImgNoSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 18 = IMAGE_ATOMIC_SUB
     { InstClass::VectorMemImgNoSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     {},
     // 20 = IMAGE_ATOMIC_SMIN
     { InstClass::VectorMemImgNoSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Sint32, ScalarType::Sint32 },
     // 21 = IMAGE_ATOMIC_UMIN
     { InstClass::VectorMemImgNoSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 22 = IMAGE_ATOMIC_SMAX
     { InstClass::VectorMemImgNoSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Sint32, ScalarType::Sint32 },
     // 23 = IMAGE_ATOMIC_UMAX
     { InstClass::VectorMemImgNoSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 24 = IMAGE_ATOMIC_AND
     { InstClass::VectorMemImgNoSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 25 = IMAGE_ATOMIC_OR
     { InstClass::VectorMemImgNoSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 26 = IMAGE_ATOMIC_XOR
     { InstClass::VectorMemImgNoSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 27 = IMAGE_ATOMIC_INC
     { InstClass::VectorMemImgNoSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 28 = IMAGE_ATOMIC_DEC
     { InstClass::VectorMemImgNoSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Uint32, ScalarType::Uint32 },
     // 29 = IMAGE_ATOMIC_FCMPSWAP
     { InstClass::VectorMemImgNoSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 30 = IMAGE_ATOMIC_FMIN
     { InstClass::VectorMemImgNoSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 31 = IMAGE_ATOMIC_FMAX
     { InstClass::VectorMemImgNoSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 32 = IMAGE_SAMPLE
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
         ScalarType::Float32, ScalarType::Float32 },
@@ -3719,21 +3751,21 @@ constexpr std::array<InstFormat, 112> InstructionFormatMIMG = { {
         ScalarType::Float32, ScalarType::Float32 },
     // 64 = IMAGE_GATHER4
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 65 = IMAGE_GATHER4_CL
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     {},
     {},
     // 68 = IMAGE_GATHER4_L
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 69 = IMAGE_GATHER4_B
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 70 = IMAGE_GATHER4_B_CL
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 71 = IMAGE_GATHER4_LZ
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
         ScalarType::Uint32, ScalarType::Float32 },
@@ -3742,61 +3774,61 @@ constexpr std::array<InstFormat, 112> InstructionFormatMIMG = { {
         ScalarType::Uint32, ScalarType::Float32 },
     // 73 = IMAGE_GATHER4_C_CL
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     {},
     {},
     // 76 = IMAGE_GATHER4_C_L
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 77 = IMAGE_GATHER4_C_B
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 78 = IMAGE_GATHER4_C_B_CL
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 79 = IMAGE_GATHER4_C_LZ
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 80 = IMAGE_GATHER4_O
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 81 = IMAGE_GATHER4_CL_O
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     {},
     {},
     // 84 = IMAGE_GATHER4_L_O
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 85 = IMAGE_GATHER4_B_O
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 86 = IMAGE_GATHER4_B_CL_O
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 87 = IMAGE_GATHER4_LZ_O
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
         ScalarType::Uint32, ScalarType::Float32 },
     // 88 = IMAGE_GATHER4_C_O
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 89 = IMAGE_GATHER4_C_CL_O
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     {},
     {},
     // 92 = IMAGE_GATHER4_C_L_O
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 93 = IMAGE_GATHER4_C_B_O
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 94 = IMAGE_GATHER4_C_B_CL_O
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 95 = IMAGE_GATHER4_C_LZ_O
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 96 = IMAGE_GET_LOD
     { InstClass::VectorMemImgUt, InstCategory::VectorMemory, 4, 1,
         ScalarType::Float32, ScalarType::Float32 },
@@ -3809,28 +3841,28 @@ constexpr std::array<InstFormat, 112> InstructionFormatMIMG = { {
     {},
     // 104 = IMAGE_SAMPLE_CD
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 105 = IMAGE_SAMPLE_CD_CL
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 106 = IMAGE_SAMPLE_C_CD
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 107 = IMAGE_SAMPLE_C_CD_CL
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 108 = IMAGE_SAMPLE_CD_O
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 109 = IMAGE_SAMPLE_CD_CL_O
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 110 = IMAGE_SAMPLE_C_CD_O
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
     // 111 = IMAGE_SAMPLE_C_CD_CL_O
     { InstClass::VectorMemImgSmp, InstCategory::VectorMemory, 4, 1,
-        ScalarType::Undefined, ScalarType::Undefined },
+        ScalarType::Float32, ScalarType::Float32 },
 } };
 
 constexpr std::array<InstFormat, 1> InstructionFormatEXP = { {
@@ -3838,43 +3870,124 @@ constexpr std::array<InstFormat, 1> InstructionFormatEXP = { {
         ScalarType::Float32, ScalarType::Any },
 } };
 
-InstFormat InstructionFormat(InstEncoding encoding, uint32_t opcode) {
+namespace {
+
+constexpr u32 NumOpcodes = u32(OpcodeMap::OP_MAP_EXP) + u32(OpcodeEXP::OP_RANGE_EXP);
+
+// VOPC, VOP2 and VOP1 are laid out contiguously in the unified opcode space. Their VOP3 encoded
+// forms may have a different format, so they get a second set of entries after the native ones.
+constexpr u32 Vop3PromotedBase = u32(OpcodeMap::OP_MAP_VOPC);
+constexpr u32 NumVop3PromotedOpcodes = u32(OpcodeMap::OP_MAP_VOP3) - Vop3PromotedBase;
+
+constexpr bool HasAdditionalLiteral(InstEncoding encoding, Opcode opcode) {
     switch (encoding) {
-    case InstEncoding::SOP1:
-        return InstructionFormatSOP1[opcode];
-    case InstEncoding::SOPP:
-        return InstructionFormatSOPP[opcode];
-    case InstEncoding::SOPC:
-        return InstructionFormatSOPC[opcode];
-    case InstEncoding::VOP1:
-        return InstructionFormatVOP1[opcode];
-    case InstEncoding::VOPC:
-        return InstructionFormatVOPC[opcode];
-    case InstEncoding::VOP3:
-        return InstructionFormatVOP3[opcode];
-    case InstEncoding::EXP:
-        return InstructionFormatEXP[opcode];
-    case InstEncoding::VINTRP:
-        return InstructionFormatVINTRP[opcode];
-    case InstEncoding::DS:
-        return InstructionFormatDS[opcode];
-    case InstEncoding::MUBUF:
-        return InstructionFormatMUBUF[opcode];
-    case InstEncoding::MTBUF:
-        return InstructionFormatMTBUF[opcode];
-    case InstEncoding::MIMG:
-        return InstructionFormatMIMG[opcode];
-    case InstEncoding::SMRD:
-        return InstructionFormatSMRD[opcode];
-    case InstEncoding::SOPK:
-        return InstructionFormatSOPK[opcode];
-    case InstEncoding::SOP2:
-        return InstructionFormatSOP2[opcode];
-    case InstEncoding::VOP2:
-        return InstructionFormatVOP2[opcode];
+    case InstEncoding::SOPK: {
+        return opcode == Opcode::S_SETREG_IMM32_B32;
+    }
+    case InstEncoding::VOP2: {
+        return opcode == Opcode::V_MADMK_F32 || opcode == Opcode::V_MADAK_F32;
+    }
+    default:
+        return false;
+    }
+}
+
+constexpr bool IsVop3BEncoding(Opcode opcode) {
+    return opcode == Opcode::V_ADD_I32 || opcode == Opcode::V_ADDC_U32 ||
+           opcode == Opcode::V_SUB_I32 || opcode == Opcode::V_SUBB_U32 ||
+           opcode == Opcode::V_SUBREV_I32 || opcode == Opcode::V_SUBBREV_U32 ||
+           opcode == Opcode::V_DIV_SCALE_F32 || opcode == Opcode::V_DIV_SCALE_F64 ||
+           opcode == Opcode::V_MAD_U64_U32 || opcode == Opcode::V_MAD_I64_I32;
+}
+
+constexpr u32 InstInfoIndex(InstEncoding encoding, Opcode opcode) {
+    const u32 index = static_cast<u32>(opcode);
+    if (encoding == InstEncoding::VOP3 && index >= Vop3PromotedBase &&
+        index < u32(OpcodeMap::OP_MAP_VOP3)) {
+        return NumOpcodes + index - Vop3PromotedBase;
     }
-    UNREACHABLE();
-    return {};
+    return index;
+}
+
+constexpr auto InstInfoTable = [] {
+    std::array<InstInfo, NumOpcodes + NumVop3PromotedOpcodes> table{};
+    const auto add = [&table](InstEncoding encoding, u32 length, Opcode opcode,
+                              const InstFormat& format) {
+        if (format == InstFormat{}) {
+            // Opcode is not defined by the ISA.
+            return;
+        }
+        table[InstInfoIndex(encoding, opcode)] = {
+            .format = format,
+            .encoding = encoding,
+            .length = static_cast<u8>(length),
+            .has_literal = HasAdditionalLiteral(encoding, opcode),
+            .is_vop3b = IsVop3BEncoding(opcode),
+        };
+    };
+    const auto add_encoding = [&add](InstEncoding encoding, u32 length, OpcodeMap map,
+                                     const auto& formats) {
+        for (u32 op = 0; op < formats.size(); ++op) {
+            add(encoding, length, static_cast<Opcode>(op + u32(map)), formats[op]);
+        }
+    };
+    add_encoding(InstEncoding::SOP2, sizeof(u32), OpcodeMap::OP_MAP_SOP2, InstructionFormatSOP2);
+    add_encoding(InstEncoding::SOPK, sizeof(u32), OpcodeMap::OP_MAP_SOPK, InstructionFormatSOPK);
+    add_encoding(InstEncoding::SOP1, sizeof(u32), OpcodeMap::OP_MAP_SOP1, InstructionFormatSOP1);
+    add_encoding(InstEncoding::SOPC, sizeof(u32), OpcodeMap::OP_MAP_SOPC, InstructionFormatSOPC);
+    add_encoding(InstEncoding::SOPP, sizeof(u32), OpcodeMap::OP_MAP_SOPP, InstructionFormatSOPP);
+    add_encoding(InstEncoding::VOPC, sizeof(u32), OpcodeMap::OP_MAP_VOPC, InstructionFormatVOPC);
+    add_encoding(InstEncoding::VOP2, sizeof(u32), OpcodeMap::OP_MAP_VOP2, InstructionFormatVOP2);
+    add_encoding(InstEncoding::VOP1, sizeof(u32), OpcodeMap::OP_MAP_VOP1, InstructionFormatVOP1);
+    add_encoding(InstEncoding::VINTRP, sizeof(u32), OpcodeMap::OP_MAP_VINTRP,
+                 InstructionFormatVINTRP);
+    add_encoding(InstEncoding::SMRD, sizeof(u32), OpcodeMap::OP_MAP_SMRD, InstructionFormatSMRD);
+    add_encoding(InstEncoding::DS, sizeof(u64), OpcodeMap::OP_MAP_DS, InstructionFormatDS);
+    add_encoding(InstEncoding::MUBUF, sizeof(u64), OpcodeMap::OP_MAP_MUBUF,
+                 InstructionFormatMUBUF);
+    add_encoding(InstEncoding::MTBUF, sizeof(u64), OpcodeMap::OP_MAP_MTBUF,
+                 InstructionFormatMTBUF);
+    add_encoding(InstEncoding::MIMG, sizeof(u64), OpcodeMap::OP_MAP_MIMG, InstructionFormatMIMG);
+    add_encoding(InstEncoding::EXP, sizeof(u64), OpcodeMap::OP_MAP_EXP, InstructionFormatEXP);
+    for (u32 op = 0; op < InstructionFormatVOP3.size(); ++op) {
+        add(InstEncoding::VOP3, sizeof(u64), MapVop3Opcode(op), InstructionFormatVOP3[op]);
+    }
+    return table;
+}();
+
+static_assert(InstructionFormatSOP2.size() == u32(OpcodeSOP2::OP_RANGE_SOP2));
+static_assert(InstructionFormatSOPK.size() == u32(OpcodeSOPK::OP_RANGE_SOPK));
+static_assert(InstructionFormatSOP1.size() == u32(OpcodeSOP1::OP_RANGE_SOP1));
+static_assert(InstructionFormatSOPC.size() == u32(OpcodeSOPC::OP_RANGE_SOPC));
+static_assert(InstructionFormatSOPP.size() == u32(OpcodeSOPP::OP_RANGE_SOPP));
+static_assert(InstructionFormatVOPC.size() == u32(OpcodeVOPC::OP_RANGE_VOPC));
+static_assert(InstructionFormatVOP2.size() == u32(OpcodeVOP2::OP_RANGE_VOP2));
+static_assert(InstructionFormatVOP1.size() == u32(OpcodeVOP1::OP_RANGE_VOP1));
+static_assert(InstructionFormatVOP3.size() == u32(OpcodeVOP3::OP_RANGE_VOP3));
+static_assert(InstructionFormatVINTRP.size() == u32(OpcodeVINTRP::OP_RANGE_VINTRP));
+static_assert(InstructionFormatSMRD.size() == u32(OpcodeSMRD::OP_RANGE_SMRD));
+static_assert(InstructionFormatDS.size() == u32(OpcodeDS::OP_RANGE_DS));
+static_assert(InstructionFormatMUBUF.size() == u32(OpcodeMUBUF::OP_RANGE_MUBUF));
+static_assert(InstructionFormatMTBUF.size() == u32(OpcodeMTBUF::OP_RANGE_MTBUF));
+static_assert(InstructionFormatMIMG.size() == u32(OpcodeMIMG::OP_RANGE_MIMG));
+static_assert(InstructionFormatEXP.size() == u32(OpcodeEXP::OP_RANGE_EXP));
+
+static_assert(std::ranges::all_of(InstInfoTable,
+                                  [](const InstInfo& info) {
+                                      return info.length == 0 ||
+                                             (info.format.src_type != ScalarType::Undefined &&
+                                              info.format.dst_type != ScalarType::Undefined);
+                                  }),
+              "Instruction format table not complete, please fix it manually.");
+
+} // Anonymous namespace
+
+const InstInfo& GetInstInfo(InstEncoding encoding, Opcode opcode) {
+    return InstInfoTable[InstInfoIndex(encoding, opcode)];
+}
+
+const InstInfo& GetInstInfo(Opcode opcode, bool vop3) {
+    return InstInfoTable[InstInfoIndex(vop3 ? InstEncoding::VOP3 : InstEncoding::ILLEGAL, opcode)];
 }
 
 } // namespace Shader::Gcn
@@ -2,13 +2,95 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "common/assert.h"
+#include "frontend/decode.h"
 #include "frontend/instruction.h"
 
 namespace Shader::Gcn {
 
+namespace {
+
+constexpr u32 OperandBits = 21;
+constexpr u32 OperandsPerWord = 3;
+constexpr u64 OperandMask = (1ULL << OperandBits) - 1;
+constexpr u32 UndefinedField = 0x1FF;
+
+union PackedOperand {
+    u32 raw;
+    BitField<0, 9, u32> field;
+    BitField<9, 4, u32> type;
+    BitField<13, 8, u32> code;
+};
+
+float OutputMultiplier(u32 omod) {
+    switch (omod) {
+    case 1:
+        return 2.0f;
+    case 2:
+        return 4.0f;
+    case 3:
+        return 0.5f;
+    default:
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+}
+
+} // Anonymous namespace
+
+InstOperand GcnInst::GetOperand(u32 slot) const {
+    const u32 shift = (slot % OperandsPerWord) * OperandBits;
+    const PackedOperand packed{static_cast<u32>((operands[slot / OperandsPerWord] >> shift) &
+                                                OperandMask)};
+    InstOperand operand{};
+    operand.type = static_cast<ScalarType>(packed.type.Value());
+    if (packed.field != UndefinedField) {
+        operand.field = static_cast<OperandField>(packed.field.Value());
+        operand.code = operand.field == OperandField::LiteralConst ? literal : packed.code.Value();
+    }
+    if (!is_vop3) {
+        return operand;
+    }
+    // VOP3 modifiers are kept in the control bits.
+    const auto& vop3 = control.vop3;
+    if (slot < 3) {
+        operand.input_modifier.abs = (vop3.abs >> slot) & 1;
+        operand.input_modifier.neg = (vop3.neg >> slot) & 1;
+    } else if (slot == GcnMaxSrcCount) {
+        operand.output_modifier.clamp = vop3.clmp;
+        operand.output_modifier.multiplier = OutputMultiplier(vop3.omod);
+    }
+    return operand;
+}
+
+void GcnInst::SetOperand(u32 slot, const InstOperand& operand) {
+    PackedOperand packed{};
+    packed.type.Assign(static_cast<u32>(operand.type));
+    if (operand.field == OperandField::Undefined) {
+        packed.field.Assign(UndefinedField);
+    } else {
+        packed.field.Assign(static_cast<u32>(operand.field));
+        // The literal constant is stored once in the instruction.
+        if (operand.field != OperandField::LiteralConst) {
+            DEBUG_ASSERT(operand.code <= 0xFF);
+            packed.code.Assign(operand.code);
+        }
+    }
+    const u32 shift = (slot % OperandsPerWord) * OperandBits;
+    u64& word = operands[slot / OperandsPerWord];
+    word = (word & ~(OperandMask << shift)) | (u64(packed.raw) << shift);
+}
+
+const InstInfo& GcnInst::Info() const {
+    return GetInstInfo(opcode, is_vop3);
+}
+
+InstEncoding GcnInst::Encoding() const {
+    return Info().encoding;
+}
+
 u32 GcnInst::BranchTarget(u32 pc) const {
-    const s16 simm = static_cast<s16>(control.sopp.simm * 4);
-    const u32 target = pc + simm + 4;
+    // Sign extend the dword offset before scaling it, it spans more than 16 bits in bytes
+    const s32 offset = static_cast<s16>(control.sopp.simm) * 4;
+    const u32 target = pc + offset + 4;
     return target;
 }
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <limits>
 #include "common/bit_field.h"
 #include "frontend/opcodes.h"
@@ -185,17 +186,39 @@ union InstControl {
     InstControlEXP exp;
 };
 
+struct InstInfo;
+
+/// Decoded instruction packed into 32 bytes.
+/// Operands are stored in 21 bits each, with the literal constant kept once per instruction and
+/// VOP3 modifiers read from the control bits. Src() and Dst() expand them on demand.
 struct GcnInst {
-    Opcode opcode;
-    InstEncoding encoding;
-    InstClass inst_class;
-    InstCategory category;
     InstControl control;
-    u32 length;
-    u32 src_count;
-    u32 dst_count;
-    std::array<InstOperand, GcnMaxSrcCount> src;
-    std::array<InstOperand, GcnMaxDstCount> dst;
+    u32 literal;
+    Opcode opcode;
+    u8 length;
+    u8 src_count : 3;
+    u8 dst_count : 2;
+    u8 is_vop3 : 1;
+    std::array<u64, 2> operands;
+
+    [[nodiscard]] InstOperand Src(u32 index) const {
+        return GetOperand(index);
+    }
+
+    [[nodiscard]] InstOperand Dst(u32 index) const {
+        return GetOperand(GcnMaxSrcCount + index);
+    }
+
+    void SetSrc(u32 index, const InstOperand& operand) {
+        SetOperand(index, operand);
+    }
+
+    void SetDst(u32 index, const InstOperand& operand) {
+        SetOperand(GcnMaxSrcCount + index, operand);
+    }
+
+    [[nodiscard]] const InstInfo& Info() const;
+    [[nodiscard]] InstEncoding Encoding() const;
 
     u32 BranchTarget(u32 pc) const;
 
@@ -203,6 +226,11 @@ struct GcnInst {
     bool IsUnconditionalBranch() const;
     bool IsConditionalBranch() const;
     bool IsFork() const;
+
+private:
+    InstOperand GetOperand(u32 slot) const;
+    void SetOperand(u32 slot, const InstOperand& operand);
 };
+static_assert(sizeof(GcnInst) == 32);
 
 } // namespace Shader::Gcn
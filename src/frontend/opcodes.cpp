@@ -0,0 +1,919 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <string_view>
+#include "frontend/opcodes.h"
+
+namespace Shader::Gcn {
+
+namespace {
+
+struct OpcodeName {
+    Opcode opcode;
+    std::string_view name;
+};
+
+constexpr OpcodeName OpcodeNames[] = {
+    // clang-format off
+    // SOP2
+    {Opcode::S_ADD_U32, "s_add_u32"},
+    {Opcode::S_SUB_U32, "s_sub_u32"},
+    {Opcode::S_ADD_I32, "s_add_i32"},
+    {Opcode::S_SUB_I32, "s_sub_i32"},
+    {Opcode::S_ADDC_U32, "s_addc_u32"},
+    {Opcode::S_SUBB_U32, "s_subb_u32"},
+    {Opcode::S_MIN_I32, "s_min_i32"},
+    {Opcode::S_MIN_U32, "s_min_u32"},
+    {Opcode::S_MAX_I32, "s_max_i32"},
+    {Opcode::S_MAX_U32, "s_max_u32"},
+    {Opcode::S_CSELECT_B32, "s_cselect_b32"},
+    {Opcode::S_CSELECT_B64, "s_cselect_b64"},
+    {Opcode::S_AND_B32, "s_and_b32"},
+    {Opcode::S_AND_B64, "s_and_b64"},
+    {Opcode::S_OR_B32, "s_or_b32"},
+    {Opcode::S_OR_B64, "s_or_b64"},
+    {Opcode::S_XOR_B32, "s_xor_b32"},
+    {Opcode::S_XOR_B64, "s_xor_b64"},
+    {Opcode::S_ANDN2_B32, "s_andn2_b32"},
+    {Opcode::S_ANDN2_B64, "s_andn2_b64"},
+    {Opcode::S_ORN2_B32, "s_orn2_b32"},
+    {Opcode::S_ORN2_B64, "s_orn2_b64"},
+    {Opcode::S_NAND_B32, "s_nand_b32"},
+    {Opcode::S_NAND_B64, "s_nand_b64"},
+    {Opcode::S_NOR_B32, "s_nor_b32"},
+    {Opcode::S_NOR_B64, "s_nor_b64"},
+    {Opcode::S_XNOR_B32, "s_xnor_b32"},
+    {Opcode::S_XNOR_B64, "s_xnor_b64"},
+    {Opcode::S_LSHL_B32, "s_lshl_b32"},
+    {Opcode::S_LSHL_B64, "s_lshl_b64"},
+    {Opcode::S_LSHR_B32, "s_lshr_b32"},
+    {Opcode::S_LSHR_B64, "s_lshr_b64"},
+    {Opcode::S_ASHR_I32, "s_ashr_i32"},
+    {Opcode::S_ASHR_I64, "s_ashr_i64"},
+    {Opcode::S_BFM_B32, "s_bfm_b32"},
+    {Opcode::S_BFM_B64, "s_bfm_b64"},
+    {Opcode::S_MUL_I32, "s_mul_i32"},
+    {Opcode::S_BFE_U32, "s_bfe_u32"},
+    {Opcode::S_BFE_I32, "s_bfe_i32"},
+    {Opcode::S_BFE_U64, "s_bfe_u64"},
+    {Opcode::S_BFE_I64, "s_bfe_i64"},
+    {Opcode::S_CBRANCH_G_FORK, "s_cbranch_g_fork"},
+    {Opcode::S_ABSDIFF_I32, "s_absdiff_i32"},
+    // SOPK
+    {Opcode::S_MOVK_I32, "s_movk_i32"},
+    {Opcode::S_CMOVK_I32, "s_cmovk_i32"},
+    {Opcode::S_CMPK_EQ_I32, "s_cmpk_eq_i32"},
+    {Opcode::S_CMPK_LG_I32, "s_cmpk_lg_i32"},
+    {Opcode::S_CMPK_GT_I32, "s_cmpk_gt_i32"},
+    {Opcode::S_CMPK_GE_I32, "s_cmpk_ge_i32"},
+    {Opcode::S_CMPK_LT_I32, "s_cmpk_lt_i32"},
+    {Opcode::S_CMPK_LE_I32, "s_cmpk_le_i32"},
+    {Opcode::S_CMPK_EQ_U32, "s_cmpk_eq_u32"},
+    {Opcode::S_CMPK_LG_U32, "s_cmpk_lg_u32"},
+    {Opcode::S_CMPK_GT_U32, "s_cmpk_gt_u32"},
+    {Opcode::S_CMPK_GE_U32, "s_cmpk_ge_u32"},
+    {Opcode::S_CMPK_LT_U32, "s_cmpk_lt_u32"},
+    {Opcode::S_CMPK_LE_U32, "s_cmpk_le_u32"},
+    {Opcode::S_ADDK_I32, "s_addk_i32"},
+    {Opcode::S_MULK_I32, "s_mulk_i32"},
+    {Opcode::S_CBRANCH_I_FORK, "s_cbranch_i_fork"},
+    {Opcode::S_GETREG_B32, "s_getreg_b32"},
+    {Opcode::S_SETREG_B32, "s_setreg_b32"},
+    {Opcode::S_GETREG_REGRD_B32, "s_getreg_regrd_b32"},
+    {Opcode::S_SETREG_IMM32_B32, "s_setreg_imm32_b32"},
+    // SOP1
+    {Opcode::S_MOV_B32, "s_mov_b32"},
+    {Opcode::S_MOV_B64, "s_mov_b64"},
+    {Opcode::S_CMOV_B32, "s_cmov_b32"},
+    {Opcode::S_CMOV_B64, "s_cmov_b64"},
+    {Opcode::S_NOT_B32, "s_not_b32"},
+    {Opcode::S_NOT_B64, "s_not_b64"},
+    {Opcode::S_WQM_B32, "s_wqm_b32"},
+    {Opcode::S_WQM_B64, "s_wqm_b64"},
+    {Opcode::S_BREV_B32, "s_brev_b32"},
+    {Opcode::S_BREV_B64, "s_brev_b64"},
+    {Opcode::S_BCNT0_I32_B32, "s_bcnt0_i32_b32"},
+    {Opcode::S_BCNT0_I32_B64, "s_bcnt0_i32_b64"},
+    {Opcode::S_BCNT1_I32_B32, "s_bcnt1_i32_b32"},
+    {Opcode::S_BCNT1_I32_B64, "s_bcnt1_i32_b64"},
+    {Opcode::S_FF0_I32_B32, "s_ff0_i32_b32"},
+    {Opcode::S_FF0_I32_B64, "s_ff0_i32_b64"},
+    {Opcode::S_FF1_I32_B32, "s_ff1_i32_b32"},
+    {Opcode::S_FF1_I32_B64, "s_ff1_i32_b64"},
+    {Opcode::S_FLBIT_I32_B32, "s_flbit_i32_b32"},
+    {Opcode::S_FLBIT_I32_B64, "s_flbit_i32_b64"},
+    {Opcode::S_FLBIT_I32, "s_flbit_i32"},
+    {Opcode::S_FLBIT_I32_I64, "s_flbit_i32_i64"},
+    {Opcode::S_SEXT_I32_I8, "s_sext_i32_i8"},
+    {Opcode::S_SEXT_I32_I16, "s_sext_i32_i16"},
+    {Opcode::S_BITSET0_B32, "s_bitset0_b32"},
+    {Opcode::S_BITSET0_B64, "s_bitset0_b64"},
+    {Opcode::S_BITSET1_B32, "s_bitset1_b32"},
+    {Opcode::S_BITSET1_B64, "s_bitset1_b64"},
+    {Opcode::S_GETPC_B64, "s_getpc_b64"},
+    {Opcode::S_SETPC_B64, "s_setpc_b64"},
+    {Opcode::S_SWAPPC_B64, "s_swappc_b64"},
+    {Opcode::S_RFE_B64, "s_rfe_b64"},
+    {Opcode::S_AND_SAVEEXEC_B64, "s_and_saveexec_b64"},
+    {Opcode::S_OR_SAVEEXEC_B64, "s_or_saveexec_b64"},
+    {Opcode::S_XOR_SAVEEXEC_B64, "s_xor_saveexec_b64"},
+    {Opcode::S_ANDN2_SAVEEXEC_B64, "s_andn2_saveexec_b64"},
+    {Opcode::S_ORN2_SAVEEXEC_B64, "s_orn2_saveexec_b64"},
+    {Opcode::S_NAND_SAVEEXEC_B64, "s_nand_saveexec_b64"},
+    {Opcode::S_NOR_SAVEEXEC_B64, "s_nor_saveexec_b64"},
+    {Opcode::S_XNOR_SAVEEXEC_B64, "s_xnor_saveexec_b64"},
+    {Opcode::S_QUADMASK_B32, "s_quadmask_b32"},
+    {Opcode::S_QUADMASK_B64, "s_quadmask_b64"},
+    {Opcode::S_MOVRELS_B32, "s_movrels_b32"},
+    {Opcode::S_MOVRELS_B64, "s_movrels_b64"},
+    {Opcode::S_MOVRELD_B32, "s_movreld_b32"},
+    {Opcode::S_MOVRELD_B64, "s_movreld_b64"},
+    {Opcode::S_CBRANCH_JOIN, "s_cbranch_join"},
+    {Opcode::S_MOV_REGRD_B32, "s_mov_regrd_b32"},
+    {Opcode::S_ABS_I32, "s_abs_i32"},
+    {Opcode::S_MOV_FED_B32, "s_mov_fed_b32"},
+    // SOPC
+    {Opcode::S_CMP_EQ_I32, "s_cmp_eq_i32"},
+    {Opcode::S_CMP_LG_I32, "s_cmp_lg_i32"},
+    {Opcode::S_CMP_GT_I32, "s_cmp_gt_i32"},
+    {Opcode::S_CMP_GE_I32, "s_cmp_ge_i32"},
+    {Opcode::S_CMP_LT_I32, "s_cmp_lt_i32"},
+    {Opcode::S_CMP_LE_I32, "s_cmp_le_i32"},
+    {Opcode::S_CMP_EQ_U32, "s_cmp_eq_u32"},
+    {Opcode::S_CMP_LG_U32, "s_cmp_lg_u32"},
+    {Opcode::S_CMP_GT_U32, "s_cmp_gt_u32"},
+    {Opcode::S_CMP_GE_U32, "s_cmp_ge_u32"},
+    {Opcode::S_CMP_LT_U32, "s_cmp_lt_u32"},
+    {Opcode::S_CMP_LE_U32, "s_cmp_le_u32"},
+    {Opcode::S_BITCMP0_B32, "s_bitcmp0_b32"},
+    {Opcode::S_BITCMP1_B32, "s_bitcmp1_b32"},
+    {Opcode::S_BITCMP0_B64, "s_bitcmp0_b64"},
+    {Opcode::S_BITCMP1_B64, "s_bitcmp1_b64"},
+    {Opcode::S_SETVSKIP, "s_setvskip"},
+    // SOPP
+    {Opcode::S_NOP, "s_nop"},
+    {Opcode::S_ENDPGM, "s_endpgm"},
+    {Opcode::S_BRANCH, "s_branch"},
+    {Opcode::S_CBRANCH_SCC0, "s_cbranch_scc0"},
+    {Opcode::S_CBRANCH_SCC1, "s_cbranch_scc1"},
+    {Opcode::S_CBRANCH_VCCZ, "s_cbranch_vccz"},
+    {Opcode::S_CBRANCH_VCCNZ, "s_cbranch_vccnz"},
+    {Opcode::S_CBRANCH_EXECZ, "s_cbranch_execz"},
+    {Opcode::S_CBRANCH_EXECNZ, "s_cbranch_execnz"},
+    {Opcode::S_BARRIER, "s_barrier"},
+    {Opcode::S_SETKILL, "s_setkill"},
+    {Opcode::S_WAITCNT, "s_waitcnt"},
+    {Opcode::S_SETHALT, "s_sethalt"},
+    {Opcode::S_SLEEP, "s_sleep"},
+    {Opcode::S_SETPRIO, "s_setprio"},
+    {Opcode::S_SENDMSG, "s_sendmsg"},
+    {Opcode::S_SENDMSGHALT, "s_sendmsghalt"},
+    {Opcode::S_TRAP, "s_trap"},
+    {Opcode::S_ICACHE_INV, "s_icache_inv"},
+    {Opcode::S_INCPERFLEVEL, "s_incperflevel"},
+    {Opcode::S_DECPERFLEVEL, "s_decperflevel"},
+    {Opcode::S_TTRACEDATA, "s_ttracedata"},
+    {Opcode::S_CBRANCH_CDBGSYS, "s_cbranch_cdbgsys"},
+    {Opcode::S_CBRANCH_CDBGUSER, "s_cbranch_cdbguser"},
+    {Opcode::S_CBRANCH_CDBGSYS_OR_USER, "s_cbranch_cdbgsys_or_user"},
+    {Opcode::S_CBRANCH_CDBGSYS_AND_USER, "s_cbranch_cdbgsys_and_user"},
+    // VOPC
+    {Opcode::V_CMP_F_F32, "v_cmp_f_f32"},
+    {Opcode::V_CMP_LT_F32, "v_cmp_lt_f32"},
+    {Opcode::V_CMP_EQ_F32, "v_cmp_eq_f32"},
+    {Opcode::V_CMP_LE_F32, "v_cmp_le_f32"},
+    {Opcode::V_CMP_GT_F32, "v_cmp_gt_f32"},
+    {Opcode::V_CMP_LG_F32, "v_cmp_lg_f32"},
+    {Opcode::V_CMP_GE_F32, "v_cmp_ge_f32"},
+    {Opcode::V_CMP_O_F32, "v_cmp_o_f32"},
+    {Opcode::V_CMP_U_F32, "v_cmp_u_f32"},
+    {Opcode::V_CMP_NGE_F32, "v_cmp_nge_f32"},
+    {Opcode::V_CMP_NLG_F32, "v_cmp_nlg_f32"},
+    {Opcode::V_CMP_NGT_F32, "v_cmp_ngt_f32"},
+    {Opcode::V_CMP_NLE_F32, "v_cmp_nle_f32"},
+    {Opcode::V_CMP_NEQ_F32, "v_cmp_neq_f32"},
+    {Opcode::V_CMP_NLT_F32, "v_cmp_nlt_f32"},
+    {Opcode::V_CMP_TRU_F32, "v_cmp_tru_f32"},
+    {Opcode::V_CMP_T_F32, "v_cmp_t_f32"},
+    {Opcode::V_CMPX_F_F32, "v_cmpx_f_f32"},
+    {Opcode::V_CMPX_LT_F32, "v_cmpx_lt_f32"},
+    {Opcode::V_CMPX_EQ_F32, "v_cmpx_eq_f32"},
+    {Opcode::V_CMPX_LE_F32, "v_cmpx_le_f32"},
+    {Opcode::V_CMPX_GT_F32, "v_cmpx_gt_f32"},
+    {Opcode::V_CMPX_LG_F32, "v_cmpx_lg_f32"},
+    {Opcode::V_CMPX_GE_F32, "v_cmpx_ge_f32"},
+    {Opcode::V_CMPX_O_F32, "v_cmpx_o_f32"},
+    {Opcode::V_CMPX_U_F32, "v_cmpx_u_f32"},
+    {Opcode::V_CMPX_NGE_F32, "v_cmpx_nge_f32"},
+    {Opcode::V_CMPX_NLG_F32, "v_cmpx_nlg_f32"},
+    {Opcode::V_CMPX_NGT_F32, "v_cmpx_ngt_f32"},
+    {Opcode::V_CMPX_NLE_F32, "v_cmpx_nle_f32"},
+    {Opcode::V_CMPX_NEQ_F32, "v_cmpx_neq_f32"},
+    {Opcode::V_CMPX_NLT_F32, "v_cmpx_nlt_f32"},
+    {Opcode::V_CMPX_TRU_F32, "v_cmpx_tru_f32"},
+    {Opcode::V_CMPX_T_F32, "v_cmpx_t_f32"},
+    {Opcode::V_CMP_F_F64, "v_cmp_f_f64"},
+    {Opcode::V_CMP_LT_F64, "v_cmp_lt_f64"},
+    {Opcode::V_CMP_EQ_F64, "v_cmp_eq_f64"},
+    {Opcode::V_CMP_LE_F64, "v_cmp_le_f64"},
+    {Opcode::V_CMP_GT_F64, "v_cmp_gt_f64"},
+    {Opcode::V_CMP_LG_F64, "v_cmp_lg_f64"},
+    {Opcode::V_CMP_GE_F64, "v_cmp_ge_f64"},
+    {Opcode::V_CMP_O_F64, "v_cmp_o_f64"},
+    {Opcode::V_CMP_U_F64, "v_cmp_u_f64"},
+    {Opcode::V_CMP_NGE_F64, "v_cmp_nge_f64"},
+    {Opcode::V_CMP_NLG_F64, "v_cmp_nlg_f64"},
+    {Opcode::V_CMP_NGT_F64, "v_cmp_ngt_f64"},
+    {Opcode::V_CMP_NLE_F64, "v_cmp_nle_f64"},
+    {Opcode::V_CMP_NEQ_F64, "v_cmp_neq_f64"},
+    {Opcode::V_CMP_NLT_F64, "v_cmp_nlt_f64"},
+    {Opcode::V_CMP_TRU_F64, "v_cmp_tru_f64"},
+    {Opcode::V_CMP_T_F64, "v_cmp_t_f64"},
+    {Opcode::V_CMPX_F_F64, "v_cmpx_f_f64"},
+    {Opcode::V_CMPX_LT_F64, "v_cmpx_lt_f64"},
+    {Opcode::V_CMPX_EQ_F64, "v_cmpx_eq_f64"},
+    {Opcode::V_CMPX_LE_F64, "v_cmpx_le_f64"},
+    {Opcode::V_CMPX_GT_F64, "v_cmpx_gt_f64"},
+    {Opcode::V_CMPX_LG_F64, "v_cmpx_lg_f64"},
+    {Opcode::V_CMPX_GE_F64, "v_cmpx_ge_f64"},
+    {Opcode::V_CMPX_O_F64, "v_cmpx_o_f64"},
+    {Opcode::V_CMPX_U_F64, "v_cmpx_u_f64"},
+    {Opcode::V_CMPX_NGE_F64, "v_cmpx_nge_f64"},
+    {Opcode::V_CMPX_NLG_F64, "v_cmpx_nlg_f64"},
+    {Opcode::V_CMPX_NGT_F64, "v_cmpx_ngt_f64"},
+    {Opcode::V_CMPX_NLE_F64, "v_cmpx_nle_f64"},
+    {Opcode::V_CMPX_NEQ_F64, "v_cmpx_neq_f64"},
+    {Opcode::V_CMPX_NLT_F64, "v_cmpx_nlt_f64"},
+    {Opcode::V_CMPX_TRU_F64, "v_cmpx_tru_f64"},
+    {Opcode::V_CMPX_T_F64, "v_cmpx_t_f64"},
+    {Opcode::V_CMPS_F_F32, "v_cmps_f_f32"},
+    {Opcode::V_CMPS_LT_F32, "v_cmps_lt_f32"},
+    {Opcode::V_CMPS_EQ_F32, "v_cmps_eq_f32"},
+    {Opcode::V_CMPS_LE_F32, "v_cmps_le_f32"},
+    {Opcode::V_CMPS_GT_F32, "v_cmps_gt_f32"},
+    {Opcode::V_CMPS_LG_F32, "v_cmps_lg_f32"},
+    {Opcode::V_CMPS_GE_F32, "v_cmps_ge_f32"},
+    {Opcode::V_CMPS_O_F32, "v_cmps_o_f32"},
+    {Opcode::V_CMPS_U_F32, "v_cmps_u_f32"},
+    {Opcode::V_CMPS_NGE_F32, "v_cmps_nge_f32"},
+    {Opcode::V_CMPS_NLG_F32, "v_cmps_nlg_f32"},
+    {Opcode::V_CMPS_NGT_F32, "v_cmps_ngt_f32"},
+    {Opcode::V_CMPS_NLE_F32, "v_cmps_nle_f32"},
+    {Opcode::V_CMPS_NEQ_F32, "v_cmps_neq_f32"},
+    {Opcode::V_CMPS_NLT_F32, "v_cmps_nlt_f32"},
+    {Opcode::V_CMPS_TRU_F32, "v_cmps_tru_f32"},
+    {Opcode::V_CMPS_T_F32, "v_cmps_t_f32"},
+    {Opcode::V_CMPSX_F_F32, "v_cmpsx_f_f32"},
+    {Opcode::V_CMPSX_LT_F32, "v_cmpsx_lt_f32"},
+    {Opcode::V_CMPSX_EQ_F32, "v_cmpsx_eq_f32"},
+    {Opcode::V_CMPSX_LE_F32, "v_cmpsx_le_f32"},
+    {Opcode::V_CMPSX_GT_F32, "v_cmpsx_gt_f32"},
+    {Opcode::V_CMPSX_LG_F32, "v_cmpsx_lg_f32"},
+    {Opcode::V_CMPSX_GE_F32, "v_cmpsx_ge_f32"},
+    {Opcode::V_CMPSX_O_F32, "v_cmpsx_o_f32"},
+    {Opcode::V_CMPSX_U_F32, "v_cmpsx_u_f32"},
+    {Opcode::V_CMPSX_NGE_F32, "v_cmpsx_nge_f32"},
+    {Opcode::V_CMPSX_NLG_F32, "v_cmpsx_nlg_f32"},
+    {Opcode::V_CMPSX_NGT_F32, "v_cmpsx_ngt_f32"},
+    {Opcode::V_CMPSX_NLE_F32, "v_cmpsx_nle_f32"},
+    {Opcode::V_CMPSX_NEQ_F32, "v_cmpsx_neq_f32"},
+    {Opcode::V_CMPSX_NLT_F32, "v_cmpsx_nlt_f32"},
+    {Opcode::V_CMPSX_TRU_F32, "v_cmpsx_tru_f32"},
+    {Opcode::V_CMPSX_T_F32, "v_cmpsx_t_f32"},
+    {Opcode::V_CMPS_F_F64, "v_cmps_f_f64"},
+    {Opcode::V_CMPS_LT_F64, "v_cmps_lt_f64"},
+    {Opcode::V_CMPS_EQ_F64, "v_cmps_eq_f64"},
+    {Opcode::V_CMPS_LE_F64, "v_cmps_le_f64"},
+    {Opcode::V_CMPS_GT_F64, "v_cmps_gt_f64"},
+    {Opcode::V_CMPS_LG_F64, "v_cmps_lg_f64"},
+    {Opcode::V_CMPS_GE_F64, "v_cmps_ge_f64"},
+    {Opcode::V_CMPS_O_F64, "v_cmps_o_f64"},
+    {Opcode::V_CMPS_U_F64, "v_cmps_u_f64"},
+    {Opcode::V_CMPS_NGE_F64, "v_cmps_nge_f64"},
+    {Opcode::V_CMPS_NLG_F64, "v_cmps_nlg_f64"},
+    {Opcode::V_CMPS_NGT_F64, "v_cmps_ngt_f64"},
+    {Opcode::V_CMPS_NLE_F64, "v_cmps_nle_f64"},
+    {Opcode::V_CMPS_NEQ_F64, "v_cmps_neq_f64"},
+    {Opcode::V_CMPS_NLT_F64, "v_cmps_nlt_f64"},
+    {Opcode::V_CMPS_TRU_F64, "v_cmps_tru_f64"},
+    {Opcode::V_CMPS_T_F64, "v_cmps_t_f64"},
+    {Opcode::V_CMPSX_F_F64, "v_cmpsx_f_f64"},
+    {Opcode::V_CMPSX_LT_F64, "v_cmpsx_lt_f64"},
+    {Opcode::V_CMPSX_EQ_F64, "v_cmpsx_eq_f64"},
+    {Opcode::V_CMPSX_LE_F64, "v_cmpsx_le_f64"},
+    {Opcode::V_CMPSX_GT_F64, "v_cmpsx_gt_f64"},
+    {Opcode::V_CMPSX_LG_F64, "v_cmpsx_lg_f64"},
+    {Opcode::V_CMPSX_GE_F64, "v_cmpsx_ge_f64"},
+    {Opcode::V_CMPSX_O_F64, "v_cmpsx_o_f64"},
+    {Opcode::V_CMPSX_U_F64, "v_cmpsx_u_f64"},
+    {Opcode::V_CMPSX_NGE_F64, "v_cmpsx_nge_f64"},
+    {Opcode::V_CMPSX_NLG_F64, "v_cmpsx_nlg_f64"},
+    {Opcode::V_CMPSX_NGT_F64, "v_cmpsx_ngt_f64"},
+    {Opcode::V_CMPSX_NLE_F64, "v_cmpsx_nle_f64"},
+    {Opcode::V_CMPSX_NEQ_F64, "v_cmpsx_neq_f64"},
+    {Opcode::V_CMPSX_NLT_F64, "v_cmpsx_nlt_f64"},
+    {Opcode::V_CMPSX_TRU_F64, "v_cmpsx_tru_f64"},
+    {Opcode::V_CMPSX_T_F64, "v_cmpsx_t_f64"},
+    {Opcode::V_CMP_F_I32, "v_cmp_f_i32"},
+    {Opcode::V_CMP_LT_I32, "v_cmp_lt_i32"},
+    {Opcode::V_CMP_EQ_I32, "v_cmp_eq_i32"},
+    {Opcode::V_CMP_LE_I32, "v_cmp_le_i32"},
+    {Opcode::V_CMP_GT_I32, "v_cmp_gt_i32"},
+    {Opcode::V_CMP_NE_I32, "v_cmp_ne_i32"},
+    {Opcode::V_CMP_GE_I32, "v_cmp_ge_i32"},
+    {Opcode::V_CMP_TRU_I32, "v_cmp_tru_i32"},
+    {Opcode::V_CMP_T_I32, "v_cmp_t_i32"},
+    {Opcode::V_CMP_CLASS_F32, "v_cmp_class_f32"},
+    {Opcode::V_CMPX_F_I32, "v_cmpx_f_i32"},
+    {Opcode::V_CMPX_LT_I32, "v_cmpx_lt_i32"},
+    {Opcode::V_CMPX_EQ_I32, "v_cmpx_eq_i32"},
+    {Opcode::V_CMPX_LE_I32, "v_cmpx_le_i32"},
+    {Opcode::V_CMPX_GT_I32, "v_cmpx_gt_i32"},
+    {Opcode::V_CMPX_LG_I32, "v_cmpx_lg_i32"},
+    {Opcode::V_CMPX_NE_I32, "v_cmpx_ne_i32"},
+    {Opcode::V_CMPX_GE_I32, "v_cmpx_ge_i32"},
+    {Opcode::V_CMPX_TRU_I32, "v_cmpx_tru_i32"},
+    {Opcode::V_CMPX_T_I32, "v_cmpx_t_i32"},
+    {Opcode::V_CMPX_CLASS_F32, "v_cmpx_class_f32"},
+    {Opcode::V_CMP_F_I64, "v_cmp_f_i64"},
+    {Opcode::V_CMP_LT_I64, "v_cmp_lt_i64"},
+    {Opcode::V_CMP_EQ_I64, "v_cmp_eq_i64"},
+    {Opcode::V_CMP_LE_I64, "v_cmp_le_i64"},
+    {Opcode::V_CMP_GT_I64, "v_cmp_gt_i64"},
+    {Opcode::V_CMP_LG_I64, "v_cmp_lg_i64"},
+    {Opcode::V_CMP_NE_I64, "v_cmp_ne_i64"},
+    {Opcode::V_CMP_GE_I64, "v_cmp_ge_i64"},
+    {Opcode::V_CMP_TRU_I64, "v_cmp_tru_i64"},
+    {Opcode::V_CMP_T_I64, "v_cmp_t_i64"},
+    {Opcode::V_CMP_CLASS_F64, "v_cmp_class_f64"},
+    {Opcode::V_CMPX_F_I64, "v_cmpx_f_i64"},
+    {Opcode::V_CMPX_LT_I64, "v_cmpx_lt_i64"},
+    {Opcode::V_CMPX_EQ_I64, "v_cmpx_eq_i64"},
+    {Opcode::V_CMPX_LE_I64, "v_cmpx_le_i64"},
+    {Opcode::V_CMPX_GT_I64, "v_cmpx_gt_i64"},
+    {Opcode::V_CMPX_LG_I64, "v_cmpx_lg_i64"},
+    {Opcode::V_CMPX_NE_I64, "v_cmpx_ne_i64"},
+    {Opcode::V_CMPX_GE_I64, "v_cmpx_ge_i64"},
+    {Opcode::V_CMPX_TRU_I64, "v_cmpx_tru_i64"},
+    {Opcode::V_CMPX_T_I64, "v_cmpx_t_i64"},
+    {Opcode::V_CMPX_CLASS_F64, "v_cmpx_class_f64"},
+    {Opcode::V_CMP_F_U32, "v_cmp_f_u32"},
+    {Opcode::V_CMP_LT_U32, "v_cmp_lt_u32"},
+    {Opcode::V_CMP_EQ_U32, "v_cmp_eq_u32"},
+    {Opcode::V_CMP_LE_U32, "v_cmp_le_u32"},
+    {Opcode::V_CMP_GT_U32, "v_cmp_gt_u32"},
+    {Opcode::V_CMP_NE_U32, "v_cmp_ne_u32"},
+    {Opcode::V_CMP_GE_U32, "v_cmp_ge_u32"},
+    {Opcode::V_CMP_TRU_U32, "v_cmp_tru_u32"},
+    {Opcode::V_CMP_T_U32, "v_cmp_t_u32"},
+    {Opcode::V_CMPX_F_U32, "v_cmpx_f_u32"},
+    {Opcode::V_CMPX_LT_U32, "v_cmpx_lt_u32"},
+    {Opcode::V_CMPX_EQ_U32, "v_cmpx_eq_u32"},
+    {Opcode::V_CMPX_LE_U32, "v_cmpx_le_u32"},
+    {Opcode::V_CMPX_GT_U32, "v_cmpx_gt_u32"},
+    {Opcode::V_CMPX_NE_U32, "v_cmpx_ne_u32"},
+    {Opcode::V_CMPX_GE_U32, "v_cmpx_ge_u32"},
+    {Opcode::V_CMPX_TRU_U32, "v_cmpx_tru_u32"},
+    {Opcode::V_CMPX_T_U32, "v_cmpx_t_u32"},
+    {Opcode::V_CMP_F_U64, "v_cmp_f_u64"},
+    {Opcode::V_CMP_LT_U64, "v_cmp_lt_u64"},
+    {Opcode::V_CMP_EQ_U64, "v_cmp_eq_u64"},
+    {Opcode::V_CMP_LE_U64, "v_cmp_le_u64"},
+    {Opcode::V_CMP_GT_U64, "v_cmp_gt_u64"},
+    {Opcode::V_CMP_LG_U64, "v_cmp_lg_u64"},
+    {Opcode::V_CMP_NE_U64, "v_cmp_ne_u64"},
+    {Opcode::V_CMP_GE_U64, "v_cmp_ge_u64"},
+    {Opcode::V_CMP_TRU_U64, "v_cmp_tru_u64"},
+    {Opcode::V_CMP_T_U64, "v_cmp_t_u64"},
+    {Opcode::V_CMPX_F_U64, "v_cmpx_f_u64"},
+    {Opcode::V_CMPX_LT_U64, "v_cmpx_lt_u64"},
+    {Opcode::V_CMPX_EQ_U64, "v_cmpx_eq_u64"},
+    {Opcode::V_CMPX_LE_U64, "v_cmpx_le_u64"},
+    {Opcode::V_CMPX_GT_U64, "v_cmpx_gt_u64"},
+    {Opcode::V_CMPX_LG_U64, "v_cmpx_lg_u64"},
+    {Opcode::V_CMPX_NE_U64, "v_cmpx_ne_u64"},
+    {Opcode::V_CMPX_GE_U64, "v_cmpx_ge_u64"},
+    {Opcode::V_CMPX_TRU_U64, "v_cmpx_tru_u64"},
+    {Opcode::V_CMPX_T_U64, "v_cmpx_t_u64"},
+    // VOP2
+    {Opcode::V_CNDMASK_B32, "v_cndmask_b32"},
+    {Opcode::V_READLANE_B32, "v_readlane_b32"},
+    {Opcode::V_WRITELANE_B32, "v_writelane_b32"},
+    {Opcode::V_ADD_F32, "v_add_f32"},
+    {Opcode::V_SUB_F32, "v_sub_f32"},
+    {Opcode::V_SUBREV_F32, "v_subrev_f32"},
+    {Opcode::V_MAC_LEGACY_F32, "v_mac_legacy_f32"},
+    {Opcode::V_MUL_LEGACY_F32, "v_mul_legacy_f32"},
+    {Opcode::V_MUL_F32, "v_mul_f32"},
+    {Opcode::V_MUL_I32_I24, "v_mul_i32_i24"},
+    {Opcode::V_MUL_HI_I32_I24, "v_mul_hi_i32_i24"},
+    {Opcode::V_MUL_U32_U24, "v_mul_u32_u24"},
+    {Opcode::V_MUL_HI_U32_U24, "v_mul_hi_u32_u24"},
+    {Opcode::V_MIN_LEGACY_F32, "v_min_legacy_f32"},
+    {Opcode::V_MAX_LEGACY_F32, "v_max_legacy_f32"},
+    {Opcode::V_MIN_F32, "v_min_f32"},
+    {Opcode::V_MAX_F32, "v_max_f32"},
+    {Opcode::V_MIN_I32, "v_min_i32"},
+    {Opcode::V_MAX_I32, "v_max_i32"},
+    {Opcode::V_MIN_U32, "v_min_u32"},
+    {Opcode::V_MAX_U32, "v_max_u32"},
+    {Opcode::V_LSHR_B32, "v_lshr_b32"},
+    {Opcode::V_LSHRREV_B32, "v_lshrrev_b32"},
+    {Opcode::V_ASHR_I32, "v_ashr_i32"},
+    {Opcode::V_ASHRREV_I32, "v_ashrrev_i32"},
+    {Opcode::V_LSHL_B32, "v_lshl_b32"},
+    {Opcode::V_LSHLREV_B32, "v_lshlrev_b32"},
+    {Opcode::V_AND_B32, "v_and_b32"},
+    {Opcode::V_OR_B32, "v_or_b32"},
+    {Opcode::V_XOR_B32, "v_xor_b32"},
+    {Opcode::V_BFM_B32, "v_bfm_b32"},
+    {Opcode::V_MAC_F32, "v_mac_f32"},
+    {Opcode::V_MADMK_F32, "v_madmk_f32"},
+    {Opcode::V_MADAK_F32, "v_madak_f32"},
+    {Opcode::V_BCNT_U32_B32, "v_bcnt_u32_b32"},
+    {Opcode::V_MBCNT_LO_U32_B32, "v_mbcnt_lo_u32_b32"},
+    {Opcode::V_MBCNT_HI_U32_B32, "v_mbcnt_hi_u32_b32"},
+    {Opcode::V_ADD_I32, "v_add_i32"},
+    {Opcode::V_SUB_I32, "v_sub_i32"},
+    {Opcode::V_SUBREV_I32, "v_subrev_i32"},
+    {Opcode::V_ADDC_U32, "v_addc_u32"},
+    {Opcode::V_SUBB_U32, "v_subb_u32"},
+    {Opcode::V_SUBBREV_U32, "v_subbrev_u32"},
+    {Opcode::V_LDEXP_F32, "v_ldexp_f32"},
+    {Opcode::V_CVT_PKACCUM_U8_F32, "v_cvt_pkaccum_u8_f32"},
+    {Opcode::V_CVT_PKNORM_I16_F32, "v_cvt_pknorm_i16_f32"},
+    {Opcode::V_CVT_PKNORM_U16_F32, "v_cvt_pknorm_u16_f32"},
+    {Opcode::V_CVT_PKRTZ_F16_F32, "v_cvt_pkrtz_f16_f32"},
+    {Opcode::V_CVT_PK_U16_U32, "v_cvt_pk_u16_u32"},
+    {Opcode::V_CVT_PK_I16_I32, "v_cvt_pk_i16_i32"},
+    // VOP1
+    {Opcode::V_NOP, "v_nop"},
+    {Opcode::V_MOV_B32, "v_mov_b32"},
+    {Opcode::V_READFIRSTLANE_B32, "v_readfirstlane_b32"},
+    {Opcode::V_CVT_I32_F64, "v_cvt_i32_f64"},
+    {Opcode::V_CVT_F64_I32, "v_cvt_f64_i32"},
+    {Opcode::V_CVT_F32_I32, "v_cvt_f32_i32"},
+    {Opcode::V_CVT_F32_U32, "v_cvt_f32_u32"},
+    {Opcode::V_CVT_U32_F32, "v_cvt_u32_f32"},
+    {Opcode::V_CVT_I32_F32, "v_cvt_i32_f32"},
+    {Opcode::V_MOV_FED_B32, "v_mov_fed_b32"},
+    {Opcode::V_CVT_F16_F32, "v_cvt_f16_f32"},
+    {Opcode::V_CVT_F32_F16, "v_cvt_f32_f16"},
+    {Opcode::V_CVT_RPI_I32_F32, "v_cvt_rpi_i32_f32"},
+    {Opcode::V_CVT_FLR_I32_F32, "v_cvt_flr_i32_f32"},
+    {Opcode::V_CVT_OFF_F32_I4, "v_cvt_off_f32_i4"},
+    {Opcode::V_CVT_F32_F64, "v_cvt_f32_f64"},
+    {Opcode::V_CVT_F64_F32, "v_cvt_f64_f32"},
+    {Opcode::V_CVT_F32_UBYTE0, "v_cvt_f32_ubyte0"},
+    {Opcode::V_CVT_F32_UBYTE1, "v_cvt_f32_ubyte1"},
+    {Opcode::V_CVT_F32_UBYTE2, "v_cvt_f32_ubyte2"},
+    {Opcode::V_CVT_F32_UBYTE3, "v_cvt_f32_ubyte3"},
+    {Opcode::V_CVT_U32_F64, "v_cvt_u32_f64"},
+    {Opcode::V_CVT_F64_U32, "v_cvt_f64_u32"},
+    {Opcode::V_TRUNC_F64, "v_trunc_f64"},
+    {Opcode::V_CEIL_F64, "v_ceil_f64"},
+    {Opcode::V_RNDNE_F64, "v_rndne_f64"},
+    {Opcode::V_FLOOR_F64, "v_floor_f64"},
+    {Opcode::V_FRACT_F32, "v_fract_f32"},
+    {Opcode::V_TRUNC_F32, "v_trunc_f32"},
+    {Opcode::V_CEIL_F32, "v_ceil_f32"},
+    {Opcode::V_RNDNE_F32, "v_rndne_f32"},
+    {Opcode::V_FLOOR_F32, "v_floor_f32"},
+    {Opcode::V_EXP_F32, "v_exp_f32"},
+    {Opcode::V_LOG_CLAMP_F32, "v_log_clamp_f32"},
+    {Opcode::V_LOG_F32, "v_log_f32"},
+    {Opcode::V_RCP_CLAMP_F32, "v_rcp_clamp_f32"},
+    {Opcode::V_RCP_LEGACY_F32, "v_rcp_legacy_f32"},
+    {Opcode::V_RCP_F32, "v_rcp_f32"},
+    {Opcode::V_RCP_IFLAG_F32, "v_rcp_iflag_f32"},
+    {Opcode::V_RSQ_CLAMP_F32, "v_rsq_clamp_f32"},
+    {Opcode::V_RSQ_LEGACY_F32, "v_rsq_legacy_f32"},
+    {Opcode::V_RSQ_F32, "v_rsq_f32"},
+    {Opcode::V_RCP_F64, "v_rcp_f64"},
+    {Opcode::V_RCP_CLAMP_F64, "v_rcp_clamp_f64"},
+    {Opcode::V_RSQ_F64, "v_rsq_f64"},
+    {Opcode::V_RSQ_CLAMP_F64, "v_rsq_clamp_f64"},
+    {Opcode::V_SQRT_F32, "v_sqrt_f32"},
+    {Opcode::V_SQRT_F64, "v_sqrt_f64"},
+    {Opcode::V_SIN_F32, "v_sin_f32"},
+    {Opcode::V_COS_F32, "v_cos_f32"},
+    {Opcode::V_NOT_B32, "v_not_b32"},
+    {Opcode::V_BFREV_B32, "v_bfrev_b32"},
+    {Opcode::V_FFBH_U32, "v_ffbh_u32"},
+    {Opcode::V_FFBL_B32, "v_ffbl_b32"},
+    {Opcode::V_FFBH_I32, "v_ffbh_i32"},
+    {Opcode::V_FREXP_EXP_I32_F64, "v_frexp_exp_i32_f64"},
+    {Opcode::V_FREXP_MANT_F64, "v_frexp_mant_f64"},
+    {Opcode::V_FRACT_F64, "v_fract_f64"},
+    {Opcode::V_FREXP_EXP_I32_F32, "v_frexp_exp_i32_f32"},
+    {Opcode::V_FREXP_MANT_F32, "v_frexp_mant_f32"},
+    {Opcode::V_CLREXCP, "v_clrexcp"},
+    {Opcode::V_MOVRELD_B32, "v_movreld_b32"},
+    {Opcode::V_MOVRELS_B32, "v_movrels_b32"},
+    {Opcode::V_MOVRELSD_B32, "v_movrelsd_b32"},
+    {Opcode::V_LOG_LEGACY_F32, "v_log_legacy_f32"},
+    {Opcode::V_EXP_LEGACY_F32, "v_exp_legacy_f32"},
+    // VOP3
+    {Opcode::V_MAD_LEGACY_F32, "v_mad_legacy_f32"},
+    {Opcode::V_MAD_F32, "v_mad_f32"},
+    {Opcode::V_MAD_I32_I24, "v_mad_i32_i24"},
+    {Opcode::V_MAD_U32_U24, "v_mad_u32_u24"},
+    {Opcode::V_CUBEID_F32, "v_cubeid_f32"},
+    {Opcode::V_CUBESC_F32, "v_cubesc_f32"},
+    {Opcode::V_CUBETC_F32, "v_cubetc_f32"},
+    {Opcode::V_CUBEMA_F32, "v_cubema_f32"},
+    {Opcode::V_BFE_U32, "v_bfe_u32"},
+    {Opcode::V_BFE_I32, "v_bfe_i32"},
+    {Opcode::V_BFI_B32, "v_bfi_b32"},
+    {Opcode::V_FMA_F32, "v_fma_f32"},
+    {Opcode::V_FMA_F64, "v_fma_f64"},
+    {Opcode::V_LERP_U8, "v_lerp_u8"},
+    {Opcode::V_ALIGNBIT_B32, "v_alignbit_b32"},
+    {Opcode::V_ALIGNBYTE_B32, "v_alignbyte_b32"},
+    {Opcode::V_MULLIT_F32, "v_mullit_f32"},
+    {Opcode::V_MIN3_F32, "v_min3_f32"},
+    {Opcode::V_MIN3_I32, "v_min3_i32"},
+    {Opcode::V_MIN3_U32, "v_min3_u32"},
+    {Opcode::V_MAX3_F32, "v_max3_f32"},
+    {Opcode::V_MAX3_I32, "v_max3_i32"},
+    {Opcode::V_MAX3_U32, "v_max3_u32"},
+    {Opcode::V_MED3_F32, "v_med3_f32"},
+    {Opcode::V_MED3_I32, "v_med3_i32"},
+    {Opcode::V_MED3_U32, "v_med3_u32"},
+    {Opcode::V_SAD_U8, "v_sad_u8"},
+    {Opcode::V_SAD_HI_U8, "v_sad_hi_u8"},
+    {Opcode::V_SAD_U16, "v_sad_u16"},
+    {Opcode::V_SAD_U32, "v_sad_u32"},
+    {Opcode::V_CVT_PK_U8_F32, "v_cvt_pk_u8_f32"},
+    {Opcode::V_DIV_FIXUP_F32, "v_div_fixup_f32"},
+    {Opcode::V_DIV_FIXUP_F64, "v_div_fixup_f64"},
+    {Opcode::V_LSHL_B64, "v_lshl_b64"},
+    {Opcode::V_LSHR_B64, "v_lshr_b64"},
+    {Opcode::V_ASHR_I64, "v_ashr_i64"},
+    {Opcode::V_ADD_F64, "v_add_f64"},
+    {Opcode::V_MUL_F64, "v_mul_f64"},
+    {Opcode::V_MIN_F64, "v_min_f64"},
+    {Opcode::V_MAX_F64, "v_max_f64"},
+    {Opcode::V_LDEXP_F64, "v_ldexp_f64"},
+    {Opcode::V_MUL_LO_U32, "v_mul_lo_u32"},
+    {Opcode::V_MUL_HI_U32, "v_mul_hi_u32"},
+    {Opcode::V_MUL_LO_I32, "v_mul_lo_i32"},
+    {Opcode::V_MUL_HI_I32, "v_mul_hi_i32"},
+    {Opcode::V_DIV_SCALE_F32, "v_div_scale_f32"},
+    {Opcode::V_DIV_SCALE_F64, "v_div_scale_f64"},
+    {Opcode::V_DIV_FMAS_F32, "v_div_fmas_f32"},
+    {Opcode::V_DIV_FMAS_F64, "v_div_fmas_f64"},
+    {Opcode::V_MSAD_U8, "v_msad_u8"},
+    {Opcode::V_QSAD_U8, "v_qsad_u8"},
+    {Opcode::V_QSAD_PK_U16_U8, "v_qsad_pk_u16_u8"},
+    {Opcode::V_MQSAD_U8, "v_mqsad_u8"},
+    {Opcode::V_MQSAD_PK_U16_U8, "v_mqsad_pk_u16_u8"},
+    {Opcode::V_TRIG_PREOP_F64, "v_trig_preop_f64"},
+    {Opcode::V_MQSAD_U32_U8, "v_mqsad_u32_u8"},
+    {Opcode::V_MAD_U64_U32, "v_mad_u64_u32"},
+    {Opcode::V_MAD_I64_I32, "v_mad_i64_i32"},
+    // VINTRP
+    {Opcode::V_INTERP_P1_F32, "v_interp_p1_f32"},
+    {Opcode::V_INTERP_P2_F32, "v_interp_p2_f32"},
+    {Opcode::V_INTERP_MOV_F32, "v_interp_mov_f32"},
+    // SMRD
+    {Opcode::S_LOAD_DWORD, "s_load_dword"},
+    {Opcode::S_LOAD_DWORDX2, "s_load_dwordx2"},
+    {Opcode::S_LOAD_DWORDX4, "s_load_dwordx4"},
+    {Opcode::S_LOAD_DWORDX8, "s_load_dwordx8"},
+    {Opcode::S_LOAD_DWORDX16, "s_load_dwordx16"},
+    {Opcode::S_BUFFER_LOAD_DWORD, "s_buffer_load_dword"},
+    {Opcode::S_BUFFER_LOAD_DWORDX2, "s_buffer_load_dwordx2"},
+    {Opcode::S_BUFFER_LOAD_DWORDX4, "s_buffer_load_dwordx4"},
+    {Opcode::S_BUFFER_LOAD_DWORDX8, "s_buffer_load_dwordx8"},
+    {Opcode::S_BUFFER_LOAD_DWORDX16, "s_buffer_load_dwordx16"},
+    {Opcode::S_MEMTIME, "s_memtime"},
+    {Opcode::S_DCACHE_INV, "s_dcache_inv"},
+    // DS
+    {Opcode::DS_ADD_U32, "ds_add_u32"},
+    {Opcode::DS_SUB_U32, "ds_sub_u32"},
+    {Opcode::DS_RSUB_U32, "ds_rsub_u32"},
+    {Opcode::DS_INC_U32, "ds_inc_u32"},
+    {Opcode::DS_DEC_U32, "ds_dec_u32"},
+    {Opcode::DS_MIN_I32, "ds_min_i32"},
+    {Opcode::DS_MAX_I32, "ds_max_i32"},
+    {Opcode::DS_MIN_U32, "ds_min_u32"},
+    {Opcode::DS_MAX_U32, "ds_max_u32"},
+    {Opcode::DS_AND_B32, "ds_and_b32"},
+    {Opcode::DS_OR_B32, "ds_or_b32"},
+    {Opcode::DS_XOR_B32, "ds_xor_b32"},
+    {Opcode::DS_MSKOR_B32, "ds_mskor_b32"},
+    {Opcode::DS_WRITE_B32, "ds_write_b32"},
+    {Opcode::DS_WRITE2_B32, "ds_write2_b32"},
+    {Opcode::DS_WRITE2ST64_B32, "ds_write2st64_b32"},
+    {Opcode::DS_CMPST_B32, "ds_cmpst_b32"},
+    {Opcode::DS_CMPST_F32, "ds_cmpst_f32"},
+    {Opcode::DS_MIN_F32, "ds_min_f32"},
+    {Opcode::DS_MAX_F32, "ds_max_f32"},
+    {Opcode::DS_NOP, "ds_nop"},
+    {Opcode::DS_GWS_SEMA_RELEASE_ALL, "ds_gws_sema_release_all"},
+    {Opcode::DS_GWS_INIT, "ds_gws_init"},
+    {Opcode::DS_GWS_SEMA_V, "ds_gws_sema_v"},
+    {Opcode::DS_GWS_SEMA_BR, "ds_gws_sema_br"},
+    {Opcode::DS_GWS_SEMA_P, "ds_gws_sema_p"},
+    {Opcode::DS_GWS_BARRIER, "ds_gws_barrier"},
+    {Opcode::DS_WRITE_B8, "ds_write_b8"},
+    {Opcode::DS_WRITE_B16, "ds_write_b16"},
+    {Opcode::DS_ADD_RTN_U32, "ds_add_rtn_u32"},
+    {Opcode::DS_SUB_RTN_U32, "ds_sub_rtn_u32"},
+    {Opcode::DS_RSUB_RTN_U32, "ds_rsub_rtn_u32"},
+    {Opcode::DS_INC_RTN_U32, "ds_inc_rtn_u32"},
+    {Opcode::DS_DEC_RTN_U32, "ds_dec_rtn_u32"},
+    {Opcode::DS_MIN_RTN_I32, "ds_min_rtn_i32"},
+    {Opcode::DS_MAX_RTN_I32, "ds_max_rtn_i32"},
+    {Opcode::DS_MIN_RTN_U32, "ds_min_rtn_u32"},
+    {Opcode::DS_MAX_RTN_U32, "ds_max_rtn_u32"},
+    {Opcode::DS_AND_RTN_B32, "ds_and_rtn_b32"},
+    {Opcode::DS_OR_RTN_B32, "ds_or_rtn_b32"},
+    {Opcode::DS_XOR_RTN_B32, "ds_xor_rtn_b32"},
+    {Opcode::DS_MSKOR_RTN_B32, "ds_mskor_rtn_b32"},
+    {Opcode::DS_WRXCHG_RTN_B32, "ds_wrxchg_rtn_b32"},
+    {Opcode::DS_WRXCHG2_RTN_B32, "ds_wrxchg2_rtn_b32"},
+    {Opcode::DS_WRXCHG2ST64_RTN_B32, "ds_wrxchg2st64_rtn_b32"},
+    {Opcode::DS_CMPST_RTN_B32, "ds_cmpst_rtn_b32"},
+    {Opcode::DS_CMPST_RTN_F32, "ds_cmpst_rtn_f32"},
+    {Opcode::DS_MIN_RTN_F32, "ds_min_rtn_f32"},
+    {Opcode::DS_MAX_RTN_F32, "ds_max_rtn_f32"},
+    {Opcode::DS_WRAP_RTN_B32, "ds_wrap_rtn_b32"},
+    {Opcode::DS_SWIZZLE_B32, "ds_swizzle_b32"},
+    {Opcode::DS_READ_B32, "ds_read_b32"},
+    {Opcode::DS_READ2_B32, "ds_read2_b32"},
+    {Opcode::DS_READ2ST64_B32, "ds_read2st64_b32"},
+    {Opcode::DS_READ_I8, "ds_read_i8"},
+    {Opcode::DS_READ_U8, "ds_read_u8"},
+    {Opcode::DS_READ_I16, "ds_read_i16"},
+    {Opcode::DS_READ_U16, "ds_read_u16"},
+    {Opcode::DS_CONSUME, "ds_consume"},
+    {Opcode::DS_APPEND, "ds_append"},
+    {Opcode::DS_ORDERED_COUNT, "ds_ordered_count"},
+    {Opcode::DS_ADD_U64, "ds_add_u64"},
+    {Opcode::DS_SUB_U64, "ds_sub_u64"},
+    {Opcode::DS_RSUB_U64, "ds_rsub_u64"},
+    {Opcode::DS_INC_U64, "ds_inc_u64"},
+    {Opcode::DS_DEC_U64, "ds_dec_u64"},
+    {Opcode::DS_MIN_I64, "ds_min_i64"},
+    {Opcode::DS_MAX_I64, "ds_max_i64"},
+    {Opcode::DS_MIN_U64, "ds_min_u64"},
+    {Opcode::DS_MAX_U64, "ds_max_u64"},
+    {Opcode::DS_AND_B64, "ds_and_b64"},
+    {Opcode::DS_OR_B64, "ds_or_b64"},
+    {Opcode::DS_XOR_B64, "ds_xor_b64"},
+    {Opcode::DS_MSKOR_B64, "ds_mskor_b64"},
+    {Opcode::DS_WRITE_B64, "ds_write_b64"},
+    {Opcode::DS_WRITE2_B64, "ds_write2_b64"},
+    {Opcode::DS_WRITE2ST64_B64, "ds_write2st64_b64"},
+    {Opcode::DS_CMPST_B64, "ds_cmpst_b64"},
+    {Opcode::DS_CMPST_F64, "ds_cmpst_f64"},
+    {Opcode::DS_MIN_F64, "ds_min_f64"},
+    {Opcode::DS_MAX_F64, "ds_max_f64"},
+    {Opcode::DS_ADD_RTN_U64, "ds_add_rtn_u64"},
+    {Opcode::DS_SUB_RTN_U64, "ds_sub_rtn_u64"},
+    {Opcode::DS_RSUB_RTN_U64, "ds_rsub_rtn_u64"},
+    {Opcode::DS_INC_RTN_U64, "ds_inc_rtn_u64"},
+    {Opcode::DS_DEC_RTN_U64, "ds_dec_rtn_u64"},
+    {Opcode::DS_MIN_RTN_I64, "ds_min_rtn_i64"},
+    {Opcode::DS_MAX_RTN_I64, "ds_max_rtn_i64"},
+    {Opcode::DS_MIN_RTN_U64, "ds_min_rtn_u64"},
+    {Opcode::DS_MAX_RTN_U64, "ds_max_rtn_u64"},
+    {Opcode::DS_AND_RTN_B64, "ds_and_rtn_b64"},
+    {Opcode::DS_OR_RTN_B64, "ds_or_rtn_b64"},
+    {Opcode::DS_XOR_RTN_B64, "ds_xor_rtn_b64"},
+    {Opcode::DS_MSKOR_RTN_B64, "ds_mskor_rtn_b64"},
+    {Opcode::DS_WRXCHG_RTN_B64, "ds_wrxchg_rtn_b64"},
+    {Opcode::DS_WRXCHG2_RTN_B64, "ds_wrxchg2_rtn_b64"},
+    {Opcode::DS_WRXCHG2ST64_RTN_B64, "ds_wrxchg2st64_rtn_b64"},
+    {Opcode::DS_CMPST_RTN_B64, "ds_cmpst_rtn_b64"},
+    {Opcode::DS_CMPST_RTN_F64, "ds_cmpst_rtn_f64"},
+    {Opcode::DS_MIN_RTN_F64, "ds_min_rtn_f64"},
+    {Opcode::DS_MAX_RTN_F64, "ds_max_rtn_f64"},
+    {Opcode::DS_READ_B64, "ds_read_b64"},
+    {Opcode::DS_READ2_B64, "ds_read2_b64"},
+    {Opcode::DS_READ2ST64_B64, "ds_read2st64_b64"},
+    {Opcode::DS_CONDXCHG32_RTN_B64, "ds_condxchg32_rtn_b64"},
+    {Opcode::DS_ADD_SRC2_U32, "ds_add_src2_u32"},
+    {Opcode::DS_SUB_SRC2_U32, "ds_sub_src2_u32"},
+    {Opcode::DS_RSUB_SRC2_U32, "ds_rsub_src2_u32"},
+    {Opcode::DS_INC_SRC2_U32, "ds_inc_src2_u32"},
+    {Opcode::DS_DEC_SRC2_U32, "ds_dec_src2_u32"},
+    {Opcode::DS_MIN_SRC2_I32, "ds_min_src2_i32"},
+    {Opcode::DS_MAX_SRC2_I32, "ds_max_src2_i32"},
+    {Opcode::DS_MIN_SRC2_U32, "ds_min_src2_u32"},
+    {Opcode::DS_MAX_SRC2_U32, "ds_max_src2_u32"},
+    {Opcode::DS_AND_SRC2_B32, "ds_and_src2_b32"},
+    {Opcode::DS_OR_SRC2_B32, "ds_or_src2_b32"},
+    {Opcode::DS_XOR_SRC2_B32, "ds_xor_src2_b32"},
+    {Opcode::DS_WRITE_SRC2_B32, "ds_write_src2_b32"},
+    {Opcode::DS_MIN_SRC2_F32, "ds_min_src2_f32"},
+    {Opcode::DS_MAX_SRC2_F32, "ds_max_src2_f32"},
+    {Opcode::DS_ADD_SRC2_U64, "ds_add_src2_u64"},
+    {Opcode::DS_SUB_SRC2_U64, "ds_sub_src2_u64"},
+    {Opcode::DS_RSUB_SRC2_U64, "ds_rsub_src2_u64"},
+    {Opcode::DS_INC_SRC2_U64, "ds_inc_src2_u64"},
+    {Opcode::DS_DEC_SRC2_U64, "ds_dec_src2_u64"},
+    {Opcode::DS_MIN_SRC2_I64, "ds_min_src2_i64"},
+    {Opcode::DS_MAX_SRC2_I64, "ds_max_src2_i64"},
+    {Opcode::DS_MIN_SRC2_U64, "ds_min_src2_u64"},
+    {Opcode::DS_MAX_SRC2_U64, "ds_max_src2_u64"},
+    {Opcode::DS_AND_SRC2_B64, "ds_and_src2_b64"},
+    {Opcode::DS_OR_SRC2_B64, "ds_or_src2_b64"},
+    {Opcode::DS_XOR_SRC2_B64, "ds_xor_src2_b64"},
+    {Opcode::DS_WRITE_SRC2_B64, "ds_write_src2_b64"},
+    {Opcode::DS_MIN_SRC2_F64, "ds_min_src2_f64"},
+    {Opcode::DS_MAX_SRC2_F64, "ds_max_src2_f64"},
+    {Opcode::DS_WRITE_B96, "ds_write_b96"},
+    {Opcode::DS_WRITE_B128, "ds_write_b128"},
+    {Opcode::DS_CONDXCHG32_RTN_B128, "ds_condxchg32_rtn_b128"},
+    {Opcode::DS_READ_B96, "ds_read_b96"},
+    {Opcode::DS_READ_B128, "ds_read_b128"},
+    // MUBUF
+    {Opcode::BUFFER_LOAD_FORMAT_X, "buffer_load_format_x"},
+    {Opcode::BUFFER_LOAD_FORMAT_XY, "buffer_load_format_xy"},
+    {Opcode::BUFFER_LOAD_FORMAT_XYZ, "buffer_load_format_xyz"},
+    {Opcode::BUFFER_LOAD_FORMAT_XYZW, "buffer_load_format_xyzw"},
+    {Opcode::BUFFER_STORE_FORMAT_X, "buffer_store_format_x"},
+    {Opcode::BUFFER_STORE_FORMAT_XY, "buffer_store_format_xy"},
+    {Opcode::BUFFER_STORE_FORMAT_XYZ, "buffer_store_format_xyz"},
+    {Opcode::BUFFER_STORE_FORMAT_XYZW, "buffer_store_format_xyzw"},
+    {Opcode::BUFFER_LOAD_UBYTE, "buffer_load_ubyte"},
+    {Opcode::BUFFER_LOAD_SBYTE, "buffer_load_sbyte"},
+    {Opcode::BUFFER_LOAD_USHORT, "buffer_load_ushort"},
+    {Opcode::BUFFER_LOAD_SSHORT, "buffer_load_sshort"},
+    {Opcode::BUFFER_LOAD_DWORD, "buffer_load_dword"},
+    {Opcode::BUFFER_LOAD_DWORDX2, "buffer_load_dwordx2"},
+    {Opcode::BUFFER_LOAD_DWORDX4, "buffer_load_dwordx4"},
+    {Opcode::BUFFER_LOAD_DWORDX3, "buffer_load_dwordx3"},
+    {Opcode::BUFFER_STORE_BYTE, "buffer_store_byte"},
+    {Opcode::BUFFER_STORE_SHORT, "buffer_store_short"},
+    {Opcode::BUFFER_STORE_DWORD, "buffer_store_dword"},
+    {Opcode::BUFFER_STORE_DWORDX2, "buffer_store_dwordx2"},
+    {Opcode::BUFFER_STORE_DWORDX4, "buffer_store_dwordx4"},
+    {Opcode::BUFFER_STORE_DWORDX3, "buffer_store_dwordx3"},
+    {Opcode::BUFFER_ATOMIC_SWAP, "buffer_atomic_swap"},
+    {Opcode::BUFFER_ATOMIC_CMPSWAP, "buffer_atomic_cmpswap"},
+    {Opcode::BUFFER_ATOMIC_ADD, "buffer_atomic_add"},
+    {Opcode::BUFFER_ATOMIC_SUB, "buffer_atomic_sub"},
+    {Opcode::BUFFER_ATOMIC_SMIN, "buffer_atomic_smin"},
+    {Opcode::BUFFER_ATOMIC_UMIN, "buffer_atomic_umin"},
+    {Opcode::BUFFER_ATOMIC_SMAX, "buffer_atomic_smax"},
+    {Opcode::BUFFER_ATOMIC_UMAX, "buffer_atomic_umax"},
+    {Opcode::BUFFER_ATOMIC_AND, "buffer_atomic_and"},
+    {Opcode::BUFFER_ATOMIC_OR, "buffer_atomic_or"},
+    {Opcode::BUFFER_ATOMIC_XOR, "buffer_atomic_xor"},
+    {Opcode::BUFFER_ATOMIC_INC, "buffer_atomic_inc"},
+    {Opcode::BUFFER_ATOMIC_DEC, "buffer_atomic_dec"},
+    {Opcode::BUFFER_ATOMIC_FCMPSWAP, "buffer_atomic_fcmpswap"},
+    {Opcode::BUFFER_ATOMIC_FMIN, "buffer_atomic_fmin"},
+    {Opcode::BUFFER_ATOMIC_FMAX, "buffer_atomic_fmax"},
+    {Opcode::BUFFER_ATOMIC_SWAP_X2, "buffer_atomic_swap_x2"},
+    {Opcode::BUFFER_ATOMIC_CMPSWAP_X2, "buffer_atomic_cmpswap_x2"},
+    {Opcode::BUFFER_ATOMIC_ADD_X2, "buffer_atomic_add_x2"},
+    {Opcode::BUFFER_ATOMIC_SUB_X2, "buffer_atomic_sub_x2"},
+    {Opcode::BUFFER_ATOMIC_SMIN_X2, "buffer_atomic_smin_x2"},
+    {Opcode::BUFFER_ATOMIC_UMIN_X2, "buffer_atomic_umin_x2"},
+    {Opcode::BUFFER_ATOMIC_SMAX_X2, "buffer_atomic_smax_x2"},
+    {Opcode::BUFFER_ATOMIC_UMAX_X2, "buffer_atomic_umax_x2"},
+    {Opcode::BUFFER_ATOMIC_AND_X2, "buffer_atomic_and_x2"},
+    {Opcode::BUFFER_ATOMIC_OR_X2, "buffer_atomic_or_x2"},
+    {Opcode::BUFFER_ATOMIC_XOR_X2, "buffer_atomic_xor_x2"},
+    {Opcode::BUFFER_ATOMIC_INC_X2, "buffer_atomic_inc_x2"},
+    {Opcode::BUFFER_ATOMIC_DEC_X2, "buffer_atomic_dec_x2"},
+    {Opcode::BUFFER_ATOMIC_FCMPSWAP_X2, "buffer_atomic_fcmpswap_x2"},
+    {Opcode::BUFFER_ATOMIC_FMIN_X2, "buffer_atomic_fmin_x2"},
+    {Opcode::BUFFER_ATOMIC_FMAX_X2, "buffer_atomic_fmax_x2"},
+    {Opcode::BUFFER_WBINVL1_SC, "buffer_wbinvl1_sc"},
+    {Opcode::BUFFER_WBINVL1, "buffer_wbinvl1"},
+    // MTBUF
+    {Opcode::TBUFFER_LOAD_FORMAT_X, "tbuffer_load_format_x"},
+    {Opcode::TBUFFER_LOAD_FORMAT_XY, "tbuffer_load_format_xy"},
+    {Opcode::TBUFFER_LOAD_FORMAT_XYZ, "tbuffer_load_format_xyz"},
+    {Opcode::TBUFFER_LOAD_FORMAT_XYZW, "tbuffer_load_format_xyzw"},
+    {Opcode::TBUFFER_STORE_FORMAT_X, "tbuffer_store_format_x"},
+    {Opcode::TBUFFER_STORE_FORMAT_XY, "tbuffer_store_format_xy"},
+    {Opcode::TBUFFER_STORE_FORMAT_XYZ, "tbuffer_store_format_xyz"},
+    {Opcode::TBUFFER_STORE_FORMAT_XYZW, "tbuffer_store_format_xyzw"},
+    // MIMG
+    {Opcode::IMAGE_LOAD, "image_load"},
+    {Opcode::IMAGE_LOAD_MIP, "image_load_mip"},
+    {Opcode::IMAGE_LOAD_PCK, "image_load_pck"},
+    {Opcode::IMAGE_LOAD_PCK_SGN, "image_load_pck_sgn"},
+    {Opcode::IMAGE_LOAD_MIP_PCK, "image_load_mip_pck"},
+    {Opcode::IMAGE_LOAD_MIP_PCK_SGN, "image_load_mip_pck_sgn"},
+    {Opcode::IMAGE_STORE, "image_store"},
+    {Opcode::IMAGE_STORE_MIP, "image_store_mip"},
+    {Opcode::IMAGE_STORE_PCK, "image_store_pck"},
+    {Opcode::IMAGE_STORE_MIP_PCK, "image_store_mip_pck"},
+    {Opcode::IMAGE_GET_RESINFO, "image_get_resinfo"},
+    {Opcode::IMAGE_ATOMIC_SWAP, "image_atomic_swap"},
+    {Opcode::IMAGE_ATOMIC_CMPSWAP, "image_atomic_cmpswap"},
+    {Opcode::IMAGE_ATOMIC_ADD, "image_atomic_add"},
+    {Opcode::IMAGE_ATOMIC_SUB, "image_atomic_sub"},
+    {Opcode::IMAGE_ATOMIC_SMIN, "image_atomic_smin"},
+    {Opcode::IMAGE_ATOMIC_UMIN, "image_atomic_umin"},
+    {Opcode::IMAGE_ATOMIC_SMAX, "image_atomic_smax"},
+    {Opcode::IMAGE_ATOMIC_UMAX, "image_atomic_umax"},
+    {Opcode::IMAGE_ATOMIC_AND, "image_atomic_and"},
+    {Opcode::IMAGE_ATOMIC_OR, "image_atomic_or"},
+    {Opcode::IMAGE_ATOMIC_XOR, "image_atomic_xor"},
+    {Opcode::IMAGE_ATOMIC_INC, "image_atomic_inc"},
+    {Opcode::IMAGE_ATOMIC_DEC, "image_atomic_dec"},
+    {Opcode::IMAGE_ATOMIC_FCMPSWAP, "image_atomic_fcmpswap"},
+    {Opcode::IMAGE_ATOMIC_FMIN, "image_atomic_fmin"},
+    {Opcode::IMAGE_ATOMIC_FMAX, "image_atomic_fmax"},
+    {Opcode::IMAGE_SAMPLE, "image_sample"},
+    {Opcode::IMAGE_SAMPLE_CL, "image_sample_cl"},
+    {Opcode::IMAGE_SAMPLE_D, "image_sample_d"},
+    {Opcode::IMAGE_SAMPLE_D_CL, "image_sample_d_cl"},
+    {Opcode::IMAGE_SAMPLE_L, "image_sample_l"},
+    {Opcode::IMAGE_SAMPLE_B, "image_sample_b"},
+    {Opcode::IMAGE_SAMPLE_B_CL, "image_sample_b_cl"},
+    {Opcode::IMAGE_SAMPLE_LZ, "image_sample_lz"},
+    {Opcode::IMAGE_SAMPLE_C, "image_sample_c"},
+    {Opcode::IMAGE_SAMPLE_C_CL, "image_sample_c_cl"},
+    {Opcode::IMAGE_SAMPLE_C_D, "image_sample_c_d"},
+    {Opcode::IMAGE_SAMPLE_C_D_CL, "image_sample_c_d_cl"},
+    {Opcode::IMAGE_SAMPLE_C_L, "image_sample_c_l"},
+    {Opcode::IMAGE_SAMPLE_C_B, "image_sample_c_b"},
+    {Opcode::IMAGE_SAMPLE_C_B_CL, "image_sample_c_b_cl"},
+    {Opcode::IMAGE_SAMPLE_C_LZ, "image_sample_c_lz"},
+    {Opcode::IMAGE_SAMPLE_O, "image_sample_o"},
+    {Opcode::IMAGE_SAMPLE_CL_O, "image_sample_cl_o"},
+    {Opcode::IMAGE_SAMPLE_D_O, "image_sample_d_o"},
+    {Opcode::IMAGE_SAMPLE_D_CL_O, "image_sample_d_cl_o"},
+    {Opcode::IMAGE_SAMPLE_L_O, "image_sample_l_o"},
+    {Opcode::IMAGE_SAMPLE_B_O, "image_sample_b_o"},
+    {Opcode::IMAGE_SAMPLE_B_CL_O, "image_sample_b_cl_o"},
+    {Opcode::IMAGE_SAMPLE_LZ_O, "image_sample_lz_o"},
+    {Opcode::IMAGE_SAMPLE_C_O, "image_sample_c_o"},
+    {Opcode::IMAGE_SAMPLE_C_CL_O, "image_sample_c_cl_o"},
+    {Opcode::IMAGE_SAMPLE_C_D_O, "image_sample_c_d_o"},
+    {Opcode::IMAGE_SAMPLE_C_D_CL_O, "image_sample_c_d_cl_o"},
+    {Opcode::IMAGE_SAMPLE_C_L_O, "image_sample_c_l_o"},
+    {Opcode::IMAGE_SAMPLE_C_B_O, "image_sample_c_b_o"},
+    {Opcode::IMAGE_SAMPLE_C_B_CL_O, "image_sample_c_b_cl_o"},
+    {Opcode::IMAGE_SAMPLE_C_LZ_O, "image_sample_c_lz_o"},
+    {Opcode::IMAGE_GATHER4, "image_gather4"},
+    {Opcode::IMAGE_GATHER4_CL, "image_gather4_cl"},
+    {Opcode::IMAGE_GATHER4_L, "image_gather4_l"},
+    {Opcode::IMAGE_GATHER4_B, "image_gather4_b"},
+    {Opcode::IMAGE_GATHER4_B_CL, "image_gather4_b_cl"},
+    {Opcode::IMAGE_GATHER4_LZ, "image_gather4_lz"},
+    {Opcode::IMAGE_GATHER4_C, "image_gather4_c"},
+    {Opcode::IMAGE_GATHER4_C_CL, "image_gather4_c_cl"},
+    {Opcode::IMAGE_GATHER4_C_L, "image_gather4_c_l"},
+    {Opcode::IMAGE_GATHER4_C_B, "image_gather4_c_b"},
+    {Opcode::IMAGE_GATHER4_C_B_CL, "image_gather4_c_b_cl"},
+    {Opcode::IMAGE_GATHER4_C_LZ, "image_gather4_c_lz"},
+    {Opcode::IMAGE_GATHER4_O, "image_gather4_o"},
+    {Opcode::IMAGE_GATHER4_CL_O, "image_gather4_cl_o"},
+    {Opcode::IMAGE_GATHER4_L_O, "image_gather4_l_o"},
+    {Opcode::IMAGE_GATHER4_B_O, "image_gather4_b_o"},
+    {Opcode::IMAGE_GATHER4_B_CL_O, "image_gather4_b_cl_o"},
+    {Opcode::IMAGE_GATHER4_LZ_O, "image_gather4_lz_o"},
+    {Opcode::IMAGE_GATHER4_C_O, "image_gather4_c_o"},
+    {Opcode::IMAGE_GATHER4_C_CL_O, "image_gather4_c_cl_o"},
+    {Opcode::IMAGE_GATHER4_C_L_O, "image_gather4_c_l_o"},
+    {Opcode::IMAGE_GATHER4_C_B_O, "image_gather4_c_b_o"},
+    {Opcode::IMAGE_GATHER4_C_B_CL_O, "image_gather4_c_b_cl_o"},
+    {Opcode::IMAGE_GATHER4_C_LZ_O, "image_gather4_c_lz_o"},
+    {Opcode::IMAGE_GET_LOD, "image_get_lod"},
+    {Opcode::IMAGE_SAMPLE_CD, "image_sample_cd"},
+    {Opcode::IMAGE_SAMPLE_CD_CL, "image_sample_cd_cl"},
+    {Opcode::IMAGE_SAMPLE_C_CD, "image_sample_c_cd"},
+    {Opcode::IMAGE_SAMPLE_C_CD_CL, "image_sample_c_cd_cl"},
+    {Opcode::IMAGE_SAMPLE_CD_O, "image_sample_cd_o"},
+    {Opcode::IMAGE_SAMPLE_CD_CL_O, "image_sample_cd_cl_o"},
+    {Opcode::IMAGE_SAMPLE_C_CD_O, "image_sample_c_cd_o"},
+    {Opcode::IMAGE_SAMPLE_C_CD_CL_O, "image_sample_c_cd_cl_o"},
+    // EXP
+    {Opcode::EXP, "exp"},
+    // clang-format on
+};
+
+constexpr u32 NumOpcodes = u32(OpcodeMap::OP_MAP_EXP) + u32(OpcodeEXP::OP_RANGE_EXP);
+
+/// Names indexed by unified opcode, empty for the gaps between defined opcodes.
+constexpr auto NameTable = [] {
+    std::array<std::string_view, NumOpcodes> table{};
+    for (const auto& [opcode, name] : OpcodeNames) {
+        table[static_cast<u32>(opcode)] = name;
+    }
+    return table;
+}();
+
+} // Anonymous namespace
+
+std::string_view NameOf(Opcode op) {
+    const u32 index = static_cast<u32>(op);
+    if (index >= NameTable.size() || NameTable[index].empty()) {
+        return "<unknown>";
+    }
+    return NameTable[index];
+}
+
+} // namespace Shader::Gcn
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <string_view>
+#include <fmt/format.h>
 #include "common/types.h"
 #include "common/enum.h"
 
@@ -1315,7 +1317,7 @@ enum class OpcodeMap : u32 {
     OP_MAP_EXP    = OP_MAP_MIMG + (u32)OpcodeMIMG::OP_RANGE_MIMG,
 };
 
-enum class Opcode : u32 {
+enum class Opcode : u16 {
     // SOP2
     S_ADD_U32        = 0 + (u32)OpcodeMap::OP_MAP_SOP2,
     S_SUB_U32        = 1 + (u32)OpcodeMap::OP_MAP_SOP2,
@@ -2480,4 +2482,18 @@ enum class ImageResComponent : u32 {
 };
 using ImageResFlags = Common::Flags<ImageResComponent>;
 
+/// Returns the lowercase ISA mnemonic of the opcode.
+[[nodiscard]] std::string_view NameOf(Opcode op);
+
 } // namespace Shader::Gcn
+
+template <>
+struct fmt::formatter<Shader::Gcn::Opcode> {
+    constexpr auto parse(format_parse_context& ctx) {
+        return ctx.begin();
+    }
+    template <typename FormatContext>
+    auto format(const Shader::Gcn::Opcode& op, FormatContext& ctx) const {
+        return fmt::format_to(ctx.out(), "{}", Shader::Gcn::NameOf(op));
+    }
+};
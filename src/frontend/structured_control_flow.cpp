@@ -3,8 +3,8 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <fmt/format.h>
@@ -123,8 +123,43 @@ struct Statement : ListBaseHook {
     };
     Statement* up{};
     StatementType type;
+    u32 mark{};        ///< Last walk of GotoPass::CommonAncestor that passed this statement.
+    u64 order{};       ///< Increases from the first to the last sibling.
 };
 
+/// Spacing of the order keys of a renumbered sibling list.
+constexpr u64 OrderGap = u64{1} << 20;
+/// Key of the first statement of a renumbered list, with room left to prepend statements.
+constexpr u64 FirstOrder = OrderGap << 20;
+
+void RenumberOrder(Tree& tree) {
+    u64 order{FirstOrder};
+    for (Statement& stmt : tree) {
+        stmt.order = order;
+        order += OrderGap;
+    }
+}
+
+/// Inserts stmt before pos with an order key between its neighbours.
+/// The sibling list is renumbered when the keys around pos leave no room.
+Node InsertOrdered(Tree& tree, Node pos, Statement& stmt) {
+    const Node node{tree.insert(pos, stmt)};
+    const bool is_first{node == tree.begin()};
+    const bool is_last{pos == tree.end()};
+    u64 low{is_first ? 0 : std::prev(node)->order};
+    const u64 high{is_last ? low + 2 * OrderGap : pos->order};
+    // Goto variables are reset at the start of the function, keep prepending cheap too
+    if (is_first && !is_last && high >= 2 * OrderGap) {
+        low = high - 2 * OrderGap;
+    }
+    if (high > low + 1) {
+        stmt.order = low + (high - low) / 2;
+    } else {
+        RenumberOrder(tree);
+    }
+    return node;
+}
+
 std::string DumpExpr(const Statement* stmt) {
     switch (stmt->type) {
     case StatementType::Identity:
@@ -146,9 +181,8 @@ std::string DumpExpr(const Statement* stmt) {
     for (auto stmt = tree.begin(); stmt != tree.end(); ++stmt) {
         switch (stmt->type) {
         case StatementType::Code:
-            ret += fmt::format("{}    Block {:04x} -> {:04x} (0x{:016x});\n", indent,
-                               stmt->block->begin, stmt->block->end,
-                               reinterpret_cast<uintptr_t>(stmt->block));
+            ret += fmt::format("{}    Block {:04x} -> {:04x};\n", indent, stmt->block->begin,
+                               stmt->block->end);
             break;
         case StatementType::Goto:
             ret += fmt::format("{}    if ({}) goto L{};\n", indent, DumpExpr(stmt->cond),
@@ -199,45 +233,6 @@ void SanitizeNoBreaks(const Tree& tree) {
     }
 }
 
-size_t Level(Node stmt) {
-    size_t level{0};
-    Statement* node{stmt->up};
-    while (node) {
-        ++level;
-        node = node->up;
-    }
-    return level;
-}
-
-bool IsDirectlyRelated(Node goto_stmt, Node label_stmt) {
-    const size_t goto_level{Level(goto_stmt)};
-    const size_t label_level{Level(label_stmt)};
-    size_t min_level;
-    size_t max_level;
-    Node min;
-    Node max;
-    if (label_level < goto_level) {
-        min_level = label_level;
-        max_level = goto_level;
-        min = label_stmt;
-        max = goto_stmt;
-    } else { // goto_level < label_level
-        min_level = goto_level;
-        max_level = label_level;
-        min = goto_stmt;
-        max = label_stmt;
-    }
-    while (max_level > min_level) {
-        --max_level;
-        max = max->up;
-    }
-    return min->up == max->up;
-}
-
-bool IsIndirectlyRelated(Node goto_stmt, Node label_stmt) {
-    return goto_stmt->up != label_stmt->up && !IsDirectlyRelated(goto_stmt, label_stmt);
-}
-
 [[maybe_unused]] bool AreSiblings(Node goto_stmt, Node label_stmt) noexcept {
     Node it{goto_stmt};
     do {
@@ -255,28 +250,8 @@ bool IsIndirectlyRelated(Node goto_stmt, Node label_stmt) {
     return false;
 }
 
-Node SiblingFromNephew(Node uncle, Node nephew) noexcept {
-    Statement* const parent{uncle->up};
-    Statement* it{&*nephew};
-    while (it->up != parent) {
-        it = it->up;
-    }
-    return Tree::s_iterator_to(*it);
-}
-
 bool AreOrdered(Node left_sibling, Node right_sibling) noexcept {
-    const Node end{right_sibling->up->children.end()};
-    for (auto it = right_sibling; it != end; ++it) {
-        if (it == left_sibling) {
-            return false;
-        }
-    }
-    return true;
-}
-
-bool NeedsLift(Node goto_stmt, Node label_stmt) noexcept {
-    const Node sibling{SiblingFromNephew(goto_stmt, label_stmt)};
-    return AreOrdered(sibling, goto_stmt);
+    return left_sibling->order < right_sibling->order;
 }
 
 /**
@@ -300,43 +275,65 @@ public:
     }
 
 private:
-    void RemoveGoto(Node goto_stmt) {
-        // Force goto_stmt and label_stmt to be directly related
-        const Node label_stmt{goto_stmt->label};
-        if (IsIndirectlyRelated(goto_stmt, label_stmt)) {
-            // Move goto_stmt out using outward-movement transformation until it becomes
-            // directly related to label_stmt
-            while (!IsDirectlyRelated(goto_stmt, label_stmt)) {
-                goto_stmt = MoveOutward(goto_stmt);
-            }
-        }
-        // Force goto_stmt and label_stmt to be siblings
-        if (IsDirectlyRelated(goto_stmt, label_stmt)) {
-            const size_t label_level{Level(label_stmt)};
-            size_t goto_level{Level(goto_stmt)};
-            if (goto_level > label_level) {
-                // Move goto_stmt out of its level using outward-movement transformations
-                while (goto_level > label_level) {
-                    goto_stmt = MoveOutward(goto_stmt);
-                    --goto_level;
+    /// Returns the closest statement containing both goto_stmt and label_stmt. Both sides walk
+    /// up in turns until one reaches a statement the other passed, so the cost is bounded by
+    /// their distance to it rather than by their depth.
+    Statement* CommonAncestor(Node goto_stmt, Node label_stmt) {
+        const u32 goto_mark{++mark_count};
+        const u32 label_mark{++mark_count};
+        Statement* goto_it{&*goto_stmt};
+        Statement* label_it{&*label_stmt};
+        goto_it->mark = goto_mark;
+        label_it->mark = label_mark;
+        while (true) {
+            if (goto_it->up) {
+                goto_it = goto_it->up;
+                if (goto_it->mark == label_mark) {
+                    return goto_it;
                 }
-            } else { // Level(goto_stmt) < Level(label_stmt)
-                if (NeedsLift(goto_stmt, label_stmt)) {
-                    // Lift goto_stmt to above stmt containing label_stmt using goto-lifting
-                    // transformations
-                    goto_stmt = Lift(goto_stmt);
-                }
-                // Move goto_stmt into label_stmt's level using inward-movement transformation
-                while (goto_level < label_level) {
-                    goto_stmt = MoveInward(goto_stmt);
-                    ++goto_level;
+                goto_it->mark = goto_mark;
+            }
+            if (label_it->up) {
+                label_it = label_it->up;
+                if (label_it->mark == goto_mark) {
+                    return label_it;
                 }
+                label_it->mark = label_mark;
             }
         }
-        // Expensive operation:
-        if (!AreSiblings(goto_stmt, label_stmt)) {
-            throw LogicError("Goto is not a sibling with the label");
+    }
+
+    void RemoveGoto(Node goto_stmt) {
+        const Node label_stmt{goto_stmt->label};
+        Statement* const ancestor{CommonAncestor(goto_stmt, label_stmt)};
+        const bool are_siblings{goto_stmt->up == label_stmt->up};
+        // Move goto_stmt out using outward-movement transformations until it is a sibling of
+        // label_stmt or of a statement containing it. Moves only wrap statements that come
+        // after goto_stmt in its parent, which never contain label_stmt.
+        while (goto_stmt->up != ancestor) {
+            goto_stmt = MoveOutward(goto_stmt);
+        }
+        // Statements from the sibling of goto_stmt down to label_stmt
+        label_path.clear();
+        for (Statement* it{&*label_stmt}; it != ancestor; it = it->up) {
+            label_path.push_back(Tree::s_iterator_to(*it));
+        }
+        std::ranges::reverse(label_path);
+        if (label_path.size() > 1 || are_siblings) {
+            if (AreOrdered(label_path.front(), goto_stmt)) {
+                // Lift goto_stmt to above stmt containing label_stmt using goto-lifting
+                // transformations. The lifted goto shares the new loop with that stmt.
+                // Backward gotos to a sibling label are lifted as well.
+                goto_stmt = Lift(goto_stmt, label_path.front());
+            }
+            // Move goto_stmt into label_stmt's level using inward-movement transformation
+            for (size_t depth = 0; depth + 1 < label_path.size(); depth++) {
+                goto_stmt = MoveInward(goto_stmt, label_path[depth]);
+            }
         }
+        // Expensive operation, only checked in debug builds
+        DEBUG_ASSERT_MSG(AreSiblings(goto_stmt, label_stmt),
+                         "Goto is not a sibling with the label");
         // goto_stmt and label_stmt are guaranteed to be siblings, eliminate
         if (std::next(goto_stmt) == label_stmt) {
             // Simply eliminate the goto if the label is next to it
@@ -360,28 +357,24 @@ private:
     void BuildTree(CFG& cfg, u32& label_id,
                    std::vector<Node>& gotos, Node function_insert_point,
                    std::optional<Node> return_label) {
-        Statement* const false_stmt{pool.Create(Identity{}, IR::Condition::False, &root_stmt)};
+        false_stmt = pool.Create(Identity{}, IR::Condition::False, &root_stmt);
+        has_variable.resize(label_id + cfg.blocks.size());
         Tree& root{root_stmt.children};
-        std::unordered_map<Block*, Node> local_labels;
+        // Labels are indexed like the blocks they belong to.
+        std::vector<Node> local_labels;
         local_labels.reserve(cfg.blocks.size());
 
-        for (Block& block : cfg.blocks) {
+        for (size_t i = 0; i < cfg.blocks.size(); i++) {
             Statement* const label{pool.Create(Label{}, label_id, &root_stmt)};
-            const Node label_it{root.insert(function_insert_point, *label)};
-            local_labels.emplace(&block, label_it);
+            local_labels.push_back(root.insert(function_insert_point, *label));
             ++label_id;
         }
-        for (Block& block : cfg.blocks) {
-            const Node label{local_labels.at(&block)};
+        for (BlockIndex index = 0; index < cfg.blocks.size(); index++) {
+            const Block& block{cfg.blocks[index]};
+            const Node label{local_labels[index]};
             // Insertion point
             const Node ip{std::next(label)};
 
-            // Reset goto variables before the first block and after its respective label
-            const auto make_reset_variable{[&]() -> Statement& {
-                return *pool.Create(SetVariable{}, label->id, false_stmt, &root_stmt);
-            }};
-            root.push_front(make_reset_variable());
-            root.insert(ip, make_reset_variable());
             root.insert(ip, *pool.Create(&block, &root_stmt));
 
             switch (block.end_class) {
@@ -389,16 +382,16 @@ private:
                 Statement* const always_cond{
                                              pool.Create(Identity{}, IR::Condition::True, &root_stmt)};
                 if (block.cond == IR::Condition::True) {
-                    const Node true_label{local_labels.at(block.branch_true)};
+                    const Node true_label{local_labels[block.branch_true]};
                     gotos.push_back(
                         root.insert(ip, *pool.Create(Goto{}, always_cond, true_label, &root_stmt)));
                 } else if (block.cond == IR::Condition::False) {
-                    const Node false_label{local_labels.at(block.branch_false)};
+                    const Node false_label{local_labels[block.branch_false]};
                     gotos.push_back(root.insert(
                         ip, *pool.Create(Goto{}, always_cond, false_label, &root_stmt)));
                 } else {
-                    const Node true_label{local_labels.at(block.branch_true)};
-                    const Node false_label{local_labels.at(block.branch_false)};
+                    const Node true_label{local_labels[block.branch_true]};
+                    const Node false_label{local_labels[block.branch_false]};
                     Statement* const true_cond{pool.Create(Identity{}, block.cond, &root_stmt)};
                     gotos.push_back(
                         root.insert(ip, *pool.Create(Goto{}, true_cond, true_label, &root_stmt)));
@@ -415,6 +408,22 @@ private:
             //    break;
             }
         }
+        RenumberOrder(root);
+    }
+
+    /// Goto variables are only created for gotos that can't be removed trivially. The first
+    /// time a label needs one, it is reset before the first block and after the label.
+    void AddGotoVariable(Node label) {
+        if (has_variable[label->id]) {
+            return;
+        }
+        has_variable[label->id] = true;
+        Tree& root{root_stmt.children};
+        InsertOrdered(root, root.begin(),
+                      *pool.Create(SetVariable{}, label->id, false_stmt, &root_stmt));
+        Statement* const label_parent{label->up};
+        InsertOrdered(label_parent->children, std::next(label),
+                      *pool.Create(SetVariable{}, label->id, false_stmt, label_parent));
     }
 
     void UpdateTreeUp(Statement* tree) {
@@ -430,7 +439,7 @@ private:
         Statement* const cond{pool.Create(Not{}, goto_stmt->cond, &root_stmt)};
         Statement* const if_stmt{pool.Create(If{}, cond, std::move(if_body), goto_stmt->up)};
         UpdateTreeUp(if_stmt);
-        body.insert(goto_stmt, *if_stmt);
+        InsertOrdered(body, goto_stmt, *if_stmt);
         body.erase(goto_stmt);
     }
 
@@ -441,7 +450,7 @@ private:
         Statement* const cond{goto_stmt->cond};
         Statement* const loop{pool.Create(Loop{}, cond, std::move(loop_body), goto_stmt->up)};
         UpdateTreeUp(loop);
-        body.insert(goto_stmt, *loop);
+        InsertOrdered(body, goto_stmt, *loop);
         body.erase(goto_stmt);
     }
 
@@ -456,16 +465,17 @@ private:
         }
     }
 
-    [[nodiscard]] Node MoveInward(Node goto_stmt) {
+    /// Moves goto_stmt into label_nested_stmt, a later sibling containing its label.
+    [[nodiscard]] Node MoveInward(Node goto_stmt, Node label_nested_stmt) {
         Statement* const parent{goto_stmt->up};
         Tree& body{parent->children};
         const Node label{goto_stmt->label};
-        const Node label_nested_stmt{SiblingFromNephew(goto_stmt, label)};
         const u32 label_id{label->id};
+        AddGotoVariable(label);
 
         Statement* const goto_cond{goto_stmt->cond};
         Statement* const set_var{pool.Create(SetVariable{}, label_id, goto_cond, parent)};
-        body.insert(goto_stmt, *set_var);
+        InsertOrdered(body, goto_stmt, *set_var);
 
         Tree if_body;
         if_body.splice(if_body.begin(), body, std::next(goto_stmt), label_nested_stmt);
@@ -474,7 +484,7 @@ private:
         if (!if_body.empty()) {
             Statement* const if_stmt{pool.Create(If{}, neg_var, std::move(if_body), parent)};
             UpdateTreeUp(if_stmt);
-            body.insert(goto_stmt, *if_stmt);
+            InsertOrdered(body, goto_stmt, *if_stmt);
         }
         body.erase(goto_stmt);
 
@@ -491,15 +501,16 @@ private:
         }
         Tree& nested_tree{label_nested_stmt->children};
         Statement* const new_goto{pool.Create(Goto{}, variable, label, &*label_nested_stmt)};
-        return nested_tree.insert(nested_tree.begin(), *new_goto);
+        return InsertOrdered(nested_tree, nested_tree.begin(), *new_goto);
     }
 
-    [[nodiscard]] Node Lift(Node goto_stmt) {
+    /// Lifts goto_stmt above label_nested_stmt, an earlier sibling containing its label.
+    [[nodiscard]] Node Lift(Node goto_stmt, Node label_nested_stmt) {
         Statement* const parent{goto_stmt->up};
         Tree& body{parent->children};
         const Node label{goto_stmt->label};
         const u32 label_id{label->id};
-        const Node label_nested_stmt{SiblingFromNephew(goto_stmt, label)};
+        AddGotoVariable(label);
 
         Tree loop_body;
         loop_body.splice(loop_body.begin(), body, label_nested_stmt, goto_stmt);
@@ -507,14 +518,14 @@ private:
         Statement* const variable{pool.Create(Variable{}, label_id, &root_stmt)};
         Statement* const loop_stmt{pool.Create(Loop{}, variable, std::move(loop_body), parent)};
         UpdateTreeUp(loop_stmt);
-        body.insert(goto_stmt, *loop_stmt);
+        InsertOrdered(body, goto_stmt, *loop_stmt);
 
+        Tree& loop_tree{loop_stmt->children};
         Statement* const new_goto{pool.Create(Goto{}, variable, label, loop_stmt)};
-        loop_stmt->children.push_front(*new_goto);
-        const Node new_goto_node{loop_stmt->children.begin()};
+        const Node new_goto_node{InsertOrdered(loop_tree, loop_tree.begin(), *new_goto)};
 
         Statement* const set_var{pool.Create(SetVariable{}, label_id, goto_stmt->cond, loop_stmt)};
-        loop_stmt->children.push_back(*set_var);
+        InsertOrdered(loop_tree, loop_tree.end(), *set_var);
 
         body.erase(goto_stmt);
         return new_goto_node;
@@ -524,9 +535,10 @@ private:
         const Node parent{Tree::s_iterator_to(*goto_stmt->up)};
         Tree& body{parent->children};
         const u32 label_id{goto_stmt->label->id};
+        AddGotoVariable(goto_stmt->label);
         Statement* const goto_cond{goto_stmt->cond};
         Statement* const set_goto_var{pool.Create(SetVariable{}, label_id, goto_cond, &*parent)};
-        body.insert(goto_stmt, *set_goto_var);
+        InsertOrdered(body, goto_stmt, *set_goto_var);
 
         Tree if_body;
         if_body.splice(if_body.begin(), body, std::next(goto_stmt), body.end());
@@ -535,37 +547,370 @@ private:
         Statement* const neg_cond{pool.Create(Not{}, cond, &root_stmt)};
         Statement* const if_stmt{pool.Create(If{}, neg_cond, std::move(if_body), &*parent)};
         UpdateTreeUp(if_stmt);
-        body.insert(goto_stmt, *if_stmt);
+        InsertOrdered(body, goto_stmt, *if_stmt);
 
         body.erase(goto_stmt);
 
         Statement* const new_cond{pool.Create(Variable{}, label_id, &root_stmt)};
         Statement* const new_goto{pool.Create(Goto{}, new_cond, goto_stmt->label, parent->up)};
         Tree& parent_tree{parent->up->children};
-        return parent_tree.insert(std::next(parent), *new_goto);
+        return InsertOrdered(parent_tree, std::next(parent), *new_goto);
     }
 
     Node MoveOutwardLoop(Node goto_stmt) {
         Statement* const parent{goto_stmt->up};
         Tree& body{parent->children};
         const u32 label_id{goto_stmt->label->id};
+        AddGotoVariable(goto_stmt->label);
         Statement* const goto_cond{goto_stmt->cond};
         Statement* const set_goto_var{pool.Create(SetVariable{}, label_id, goto_cond, parent)};
         Statement* const cond{pool.Create(Variable{}, label_id, &root_stmt)};
         Statement* const break_stmt{pool.Create(Break{}, cond, parent)};
-        body.insert(goto_stmt, *set_goto_var);
-        body.insert(goto_stmt, *break_stmt);
+        InsertOrdered(body, goto_stmt, *set_goto_var);
+        InsertOrdered(body, goto_stmt, *break_stmt);
         body.erase(goto_stmt);
 
         const Node loop{Tree::s_iterator_to(*goto_stmt->up)};
         Statement* const new_goto_cond{pool.Create(Variable{}, label_id, &root_stmt)};
         Statement* const new_goto{pool.Create(Goto{}, new_goto_cond, goto_stmt->label, loop->up)};
         Tree& parent_tree{loop->up->children};
-        return parent_tree.insert(std::next(loop), *new_goto);
+        return InsertOrdered(parent_tree, std::next(loop), *new_goto);
     }
 
     ObjectPool<Statement>& pool;
     Statement root_stmt{FunctionTag{}};
+    Statement* false_stmt{};
+    std::vector<bool> has_variable; ///< Indexed by label id.
+    u32 mark_count{};
+    std::vector<Node> label_path;
+};
+
+/**
+ * Builds the statement tree straight from the dominator and loop information of the graph.
+ * Only reducible graphs with properly nested regions are handled: every loop has a single
+ * latch and a single exit target besides returns, and every conditional closes where its
+ * paths meet again. The tree has no gotos, so goto elimination is skipped for these graphs.
+ */
+class StructurePass {
+public:
+    explicit StructurePass(CFG& cfg_, ObjectPool<Statement>& stmt_pool)
+        : cfg{cfg_}, pool{stmt_pool} {
+        is_structured = Structurize();
+    }
+
+    /// Returns false if the graph has an irregular shape and needs goto elimination.
+    [[nodiscard]] bool IsStructured() const noexcept {
+        return is_structured;
+    }
+
+    Statement& RootStatement() noexcept {
+        return root_stmt;
+    }
+
+private:
+    struct LoopInfo {
+        IR::LoopIndex index;
+        BlockIndex header;
+        BlockIndex latch;
+        BlockIndex exit;
+    };
+
+    bool Structurize() {
+        if (cfg.blocks.empty()) {
+            return false;
+        }
+        IR::FlowAnalysis& analysis{cfg.Analysis()};
+        forest = &analysis.Loops();
+        if (!forest->IsReducible()) {
+            return false;
+        }
+        FindReturnPaths(analysis.Dominators());
+        if (!CollectLoops()) {
+            return false;
+        }
+        BuildDominators(analysis.Graph(), analysis.Dominators());
+        emitted.assign(cfg.blocks.size(), false);
+        if (!EmitRegion(root_stmt, 0, InvalidBlock, nullptr, false)) {
+            return false;
+        }
+        const IR::DominatorTree& dom_tree{analysis.Dominators()};
+        for (BlockIndex index = 0; index < cfg.blocks.size(); index++) {
+            if (dom_tree.IsReachable(index) && !emitted[index]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Marks the blocks from which every path returns. A loop may branch to them from anywhere
+    /// in its body without them counting as loop exits.
+    void FindReturnPaths(const IR::DominatorTree& dom_tree) {
+        returns.assign(cfg.blocks.size(), false);
+        const auto rpo{dom_tree.ReversePostOrder()};
+        for (auto it = rpo.rbegin(); it != rpo.rend(); ++it) {
+            const Block& block{cfg.blocks[*it]};
+            const auto succs{block.Successors()};
+            // Successors along back edges come later in the walk and are never marked yet
+            returns[*it] = block.end_class == EndClass::Exit ||
+                           (!succs.empty() && std::ranges::all_of(succs, [this](BlockIndex succ) {
+                               return returns[succ];
+                           }));
+        }
+    }
+
+    /// Targets outside of a loop that its body branches to.
+    struct LoopExits {
+        BlockIndex exit{InvalidBlock};        ///< Target that does not return.
+        BlockIndex return_exit{InvalidBlock}; ///< Last target that returns.
+        bool single_exit{true};
+        bool single_return_exit{true};
+
+        void Add(BlockIndex target, bool returns) {
+            if (returns) {
+                single_return_exit &= return_exit == InvalidBlock || return_exit == target;
+                return_exit = target;
+            } else {
+                single_exit &= exit == InvalidBlock || exit == target;
+                exit = target;
+            }
+        }
+    };
+
+    bool CollectLoops() {
+        const auto loops{forest->Loops()};
+        // Visit every block once in its innermost loop, nested loops pass their exits up.
+        std::vector<LoopExits> exits(loops.size());
+        for (BlockIndex node = 0; node < cfg.blocks.size(); node++) {
+            const IR::LoopIndex loop{forest->LoopOf(node)};
+            if (loop == IR::InvalidLoop) {
+                continue;
+            }
+            for (const BlockIndex succ : cfg.blocks[node].Successors()) {
+                if (!forest->Contains(loop, succ)) {
+                    exits[loop].Add(succ, returns[succ]);
+                }
+            }
+        }
+        // Nested loops come before the loops containing them.
+        loop_infos.resize(loops.size());
+        for (IR::LoopIndex index = 0; index < loops.size(); index++) {
+            const IR::Loop& loop{loops[index]};
+            const LoopExits& loop_exits{exits[index]};
+            if (loop.latches.size() != 1 || !loop_exits.single_exit) {
+                return false;
+            }
+            if (loop.parent != IR::InvalidLoop) {
+                // Blocks that return are never part of a loop, so they leave the parent too
+                LoopExits& parent_exits{exits[loop.parent]};
+                if (loop_exits.exit != InvalidBlock &&
+                    !forest->Contains(loop.parent, loop_exits.exit)) {
+                    parent_exits.Add(loop_exits.exit, false);
+                }
+                if (loop_exits.return_exit != InvalidBlock) {
+                    parent_exits.Add(loop_exits.return_exit, true);
+                    parent_exits.single_return_exit &= loop_exits.single_return_exit;
+                }
+            }
+            // Blocks that return can be branched to from anywhere in the body. They only count
+            // as the exit when nothing else leaves the loop, preferring the one of the latch.
+            const BlockIndex latch{loop.latches.front()};
+            BlockIndex exit{loop_exits.exit};
+            if (exit == InvalidBlock) {
+                BlockIndex return_exit{loop_exits.return_exit};
+                bool single_return_exit{loop_exits.single_return_exit};
+                for (const BlockIndex succ : cfg.blocks[latch].Successors()) {
+                    if (!forest->Contains(index, succ)) {
+                        return_exit = succ;
+                        single_return_exit = true;
+                    }
+                }
+                exit = single_return_exit ? return_exit : InvalidBlock;
+            }
+            loop_infos[index] = {index, loop.header, latch, exit};
+        }
+        return true;
+    }
+
+    /// Dominators of the graph with back edges redirected to the loop exit and breaks removed.
+    /// That graph is acyclic and a conditional in a loop body merges before its latch.
+    /// Post-dominators also ignore branches into returning paths no other block can reach,
+    /// so a conditional with such an arm merges where its other path goes.
+    void BuildDominators(const IR::FlowGraph& graph, const IR::DominatorTree& dom_tree) {
+        std::vector<std::pair<IR::NodeIndex, IR::NodeIndex>> edges;
+        std::vector<std::pair<IR::NodeIndex, IR::NodeIndex>> post_edges;
+        edges.reserve(cfg.blocks.size() * 2);
+        post_edges.reserve(cfg.blocks.size() * 2);
+        const auto add_edge = [&](BlockIndex from, BlockIndex to) {
+            edges.emplace_back(from, to);
+            const bool is_private_return{returns[to] && graph.Predecessors(to).size() == 1 &&
+                                         dom_tree.Frontier(to).empty()};
+            if (returns[from] || !is_private_return) {
+                post_edges.emplace_back(from, to);
+            }
+        };
+        for (BlockIndex index = 0; index < cfg.blocks.size(); index++) {
+            const IR::LoopIndex loop{forest->LoopOf(index)};
+            for (const BlockIndex succ : cfg.blocks[index].Successors()) {
+                if (forest->IsHeader(succ) && loop_infos[forest->LoopOf(succ)].latch == index) {
+                    const BlockIndex exit{loop_infos[forest->LoopOf(succ)].exit};
+                    if (exit != InvalidBlock) {
+                        edges.emplace_back(index, exit);
+                        post_edges.emplace_back(index, exit);
+                    }
+                } else if (loop == IR::InvalidLoop || succ != loop_infos[loop].exit) {
+                    add_edge(index, succ);
+                }
+            }
+        }
+        const u32 num_blocks{static_cast<u32>(cfg.blocks.size())};
+        dom.emplace(IR::FlowGraph{num_blocks, 0, edges});
+        post_dom.emplace(IR::FlowGraph{num_blocks, 0, post_edges}.Reverse());
+    }
+
+    Statement* MakeCondition(IR::Condition cond, bool negate) {
+        Statement* const identity{pool.Create(Identity{}, cond, &root_stmt)};
+        return negate ? pool.Create(Not{}, identity, &root_stmt) : identity;
+    }
+
+    /// Emits the blocks from node up to stop as children of parent.
+    /// The loop body region starts at the loop header and ends at the latch.
+    bool EmitRegion(Statement& parent, BlockIndex node, BlockIndex stop, const LoopInfo* loop,
+                    bool is_loop_body) {
+        bool at_header{is_loop_body};
+        while (node != stop) {
+            if (emitted[node]) {
+                return false;
+            }
+            if (loop && !forest->Contains(loop->index, node) && !returns[node]) {
+                return false;
+            }
+            if (!at_header && forest->IsHeader(node)) {
+                const LoopInfo& inner{loop_infos[forest->LoopOf(node)]};
+                if (!EmitLoop(parent, inner)) {
+                    return false;
+                }
+                if (inner.exit == InvalidBlock) {
+                    // The loop is only left through a return
+                    return true;
+                }
+                node = inner.exit;
+                continue;
+            }
+            at_header = false;
+            emitted[node] = true;
+
+            const Block& block{cfg.blocks[node]};
+            parent.children.push_back(*pool.Create(&block, &parent));
+            if (block.end_class == EndClass::Exit) {
+                parent.children.push_back(*pool.Create(Return{}, &parent));
+                return true;
+            }
+            if (loop && node == loop->latch) {
+                // The continue block evaluates the loop condition
+                return stop == InvalidBlock;
+            }
+            if (block.cond == IR::Condition::True) {
+                node = block.branch_true;
+                continue;
+            }
+            if (block.cond == IR::Condition::False || block.branch_true == block.branch_false) {
+                node = block.branch_false;
+                continue;
+            }
+            if (loop && (block.branch_true == loop->exit || block.branch_false == loop->exit)) {
+                const bool exit_on_true{block.branch_true == loop->exit};
+                Statement* const cond{MakeCondition(block.cond, !exit_on_true)};
+                parent.children.push_back(*pool.Create(Break{}, cond, &parent));
+                node = exit_on_true ? block.branch_false : block.branch_true;
+                continue;
+            }
+            const std::optional<BlockIndex> merge{FindMerge(node, block, stop)};
+            if (!merge || !EmitIf(parent, node, block, *merge, loop)) {
+                return false;
+            }
+            node = *merge;
+        }
+        return true;
+    }
+
+    /// Returns the block where the paths of a conditional meet again, or stop if they don't.
+    std::optional<BlockIndex> FindMerge(BlockIndex node, const Block& block, BlockIndex stop) {
+        const IR::NodeIndex ipdom{post_dom->ImmediateDominator(node)};
+        if (ipdom < cfg.blocks.size()) {
+            return ipdom;
+        }
+        // Some path returns, the others may still meet where the dominance of their arm ends.
+        BlockIndex merge{stop};
+        for (const BlockIndex entry : {block.branch_true, block.branch_false}) {
+            const std::span<const IR::NodeIndex> frontier{
+                dom->ImmediateDominator(entry) == node ? dom->Frontier(entry)
+                                                       : std::span<const IR::NodeIndex>{&entry, 1}};
+            for (const IR::NodeIndex candidate : frontier) {
+                if (candidate == stop || candidate == merge) {
+                    continue;
+                }
+                if (merge != stop) {
+                    return std::nullopt;
+                }
+                merge = candidate;
+            }
+        }
+        return merge;
+    }
+
+    bool EmitIf(Statement& parent, BlockIndex node, const Block& block, BlockIndex merge,
+                const LoopInfo* loop) {
+        if (block.branch_false == merge) {
+            Statement* const cond{MakeCondition(block.cond, false)};
+            return EmitArm(parent, cond, block.branch_true, merge, loop);
+        }
+        if (block.branch_true == merge) {
+            Statement* const cond{MakeCondition(block.cond, true)};
+            return EmitArm(parent, cond, block.branch_false, merge, loop);
+        }
+        // The first arm may clobber the registers the condition reads, keep it in a variable
+        Statement* const cond{MakeCondition(block.cond, false)};
+        parent.children.push_back(*pool.Create(SetVariable{}, node, cond, &parent));
+        Statement* const variable{pool.Create(Variable{}, node, &root_stmt)};
+        Statement* const neg_var{pool.Create(Not{}, variable, &root_stmt)};
+        return EmitArm(parent, variable, block.branch_true, merge, loop) &&
+               EmitArm(parent, neg_var, block.branch_false, merge, loop);
+    }
+
+    bool EmitArm(Statement& parent, Statement* cond, BlockIndex entry, BlockIndex merge,
+                 const LoopInfo* loop) {
+        Statement* const if_stmt{pool.Create(If{}, cond, Tree{}, &parent)};
+        parent.children.push_back(*if_stmt);
+        return EmitRegion(*if_stmt, entry, merge, loop, false);
+    }
+
+    bool EmitLoop(Statement& parent, const LoopInfo& loop) {
+        const Block& latch{cfg.blocks[loop.latch]};
+        Statement* cond{};
+        if (latch.cond == IR::Condition::True || latch.cond == IR::Condition::False) {
+            cond = MakeCondition(IR::Condition::True, false);
+        } else if (latch.branch_true == loop.header && latch.branch_false == loop.exit) {
+            cond = MakeCondition(latch.cond, false);
+        } else if (latch.branch_false == loop.header && latch.branch_true == loop.exit) {
+            cond = MakeCondition(latch.cond, true);
+        } else {
+            return false;
+        }
+        Statement* const loop_stmt{pool.Create(Loop{}, cond, Tree{}, &parent)};
+        parent.children.push_back(*loop_stmt);
+        return EmitRegion(*loop_stmt, loop.header, InvalidBlock, &loop, true);
+    }
+
+    CFG& cfg;
+    ObjectPool<Statement>& pool;
+    Statement root_stmt{FunctionTag{}};
+    const IR::LoopForest* forest{};
+    std::vector<LoopInfo> loop_infos;
+    std::optional<IR::DominatorTree> dom;
+    std::optional<IR::DominatorTree> post_dom;
+    std::vector<bool> returns;
+    std::vector<bool> emitted;
+    bool is_structured{};
 };
 
 [[nodiscard]] Statement* TryFindForwardBlock(Statement& stmt) {
@@ -598,7 +943,7 @@ private:
 
 class TranslatePass {
 public:
-    TranslatePass(ObjectPool<IR::Inst>& inst_pool_, ObjectPool<IR::Block>& block_pool_,
+    TranslatePass(IR::InstPool& inst_pool_, ObjectPool<IR::Block>& block_pool_,
                   ObjectPool<Statement>& stmt_pool_, Statement& root_stmt,
                   IR::AbstractSyntaxList& syntax_list_, std::span<const GcnInst> inst_list_)
         : stmt_pool{stmt_pool_}, inst_pool{inst_pool_}, block_pool{block_pool_},
@@ -631,10 +976,13 @@ private:
                 break;
             case StatementType::Code: {
                 ensure_block();
+                // Merge blocks added by MergeBlock have no instructions
+                if (stmt.block == &dummy_flow_block) {
+                    break;
+                }
                 const u32 start = stmt.block->begin_index;
                 const u32 size = stmt.block->end_index - start + 1;
                 Translate(current_block, inst_list.subspan(start, size));
-                fmt::print("{}\n", IR::DumpBlock(*current_block));
                 break;
             }
             case StatementType::SetVariable: {
@@ -679,6 +1027,10 @@ private:
                 break;
             }
             case StatementType::Loop: {
+                // The first block gets the prologue, which must not run on every iteration
+                if (syntax_list.empty()) {
+                    ensure_block();
+                }
                 IR::Block* const loop_header_block{block_pool.Create(inst_pool)};
                 if (current_block) {
                     current_block->AddBranch(loop_header_block);
@@ -807,7 +1159,7 @@ private:
     }
 
     ObjectPool<Statement>& stmt_pool;
-    ObjectPool<IR::Inst>& inst_pool;
+    IR::InstPool& inst_pool;
     ObjectPool<IR::Block>& block_pool;
     IR::AbstractSyntaxList& syntax_list;
     const Block dummy_flow_block{};
@@ -815,15 +1167,26 @@ private:
 };
 } // Anonymous namespace
 
-IR::AbstractSyntaxList BuildASL(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Block>& block_pool,
-                                CFG& cfg) {
+IR::AbstractSyntaxList BuildASL(IR::InstPool& inst_pool, ObjectPool<IR::Block>& block_pool,
+                                CFG& cfg, ASLStats* stats, ASLPass pass) {
     ObjectPool<Statement> stmt_pool{64};
-    GotoPass goto_pass{cfg, stmt_pool};
-    Statement& root{goto_pass.RootStatement()};
-    fmt::print("{}", DumpTree(root.children));
-    std::fflush(stdout);
+    // Well nested graphs skip goto elimination, anything else goes through it.
+    std::optional<StructurePass> structure_pass;
+    if (pass == ASLPass::Auto) {
+        structure_pass.emplace(cfg, stmt_pool);
+    }
+    std::optional<GotoPass> goto_pass;
+    if (!structure_pass || !structure_pass->IsStructured()) {
+        goto_pass.emplace(cfg, stmt_pool);
+    }
+    Statement& root{goto_pass ? goto_pass->RootStatement() : structure_pass->RootStatement()};
     IR::AbstractSyntaxList syntax_list;
     TranslatePass{inst_pool, block_pool, stmt_pool, root, syntax_list, cfg.inst_list};
+    if (stats) {
+        stats->num_statements = stmt_pool.NumObjects();
+        stats->statement_bytes = stmt_pool.MemoryUsage();
+        stats->used_goto_pass = goto_pass.has_value();
+    }
     return syntax_list;
 }
 
@@ -11,7 +11,22 @@
 
 namespace Shader::Gcn {
 
-[[nodiscard]] IR::AbstractSyntaxList BuildASL(ObjectPool<IR::Inst>& inst_pool,
-                                              ObjectPool<IR::Block>& block_pool, CFG& cfg);
+/// Cost of building an abstract syntax list, for profiling the structurizer.
+struct ASLStats {
+    size_t num_statements{};  ///< Statements created while structurizing and translating.
+    size_t statement_bytes{}; ///< Memory held by the statement pool.
+    bool used_goto_pass{};    ///< The graph was not well nested and went through goto elimination.
+};
+
+/// Structurizer that builds the abstract syntax list.
+enum class ASLPass {
+    Auto, ///< Builds well nested graphs directly, the rest goes through goto elimination.
+    Goto, ///< Always goes through goto elimination, to check the direct path against it.
+};
+
+[[nodiscard]] IR::AbstractSyntaxList BuildASL(IR::InstPool& inst_pool,
+                                              ObjectPool<IR::Block>& block_pool, CFG& cfg,
+                                              ASLStats* stats = nullptr,
+                                              ASLPass pass = ASLPass::Auto);
 
 } // namespace Shader::Gcn
@@ -7,8 +7,8 @@ namespace Shader::Gcn {
 
 void Translator::DS_READ(int bit_size, bool is_signed, bool is_pair,
                          const GcnInst& inst) {
-    const IR::U32 addr{ir.GetVectorReg(IR::VectorReg(inst.src[0].code))};
-    const IR::VectorReg dst_reg{inst.dst[0].code};
+    const IR::U32 addr{ir.GetVectorReg(IR::VectorReg(inst.Src(0).code))};
+    const IR::VectorReg dst_reg{inst.Dst(0).code};
     if (is_pair) {
         const IR::U32 addr0 = ir.IAdd(addr, ir.Imm32(u32(inst.control.ds.offset0)));
         ir.SetVectorReg(dst_reg, ir.ReadShared(32, is_signed, addr0));
@@ -25,9 +25,9 @@ void Translator::DS_READ(int bit_size, bool is_signed, bool is_pair,
 }
 
 void Translator::DS_WRITE(int bit_size, bool is_signed, bool is_pair, const GcnInst& inst) {
-    const IR::U32 addr{ir.GetVectorReg(IR::VectorReg(inst.src[0].code))};
-    const IR::VectorReg data0{inst.src[1].code};
-    const IR::VectorReg data1{inst.src[2].code};
+    const IR::U32 addr{ir.GetVectorReg(IR::VectorReg(inst.Src(0).code))};
+    const IR::VectorReg data0{inst.Src(1).code};
+    const IR::VectorReg data1{inst.Src(2).code};
     if (is_pair) {
         const IR::U32 addr0 = ir.IAdd(addr, ir.Imm32(u32(inst.control.ds.offset0)));
         ir.WriteShared(32, ir.GetVectorReg(data0), addr0);
@@ -9,10 +9,10 @@ void Translator::EXP(const GcnInst& inst) {
     const auto& exp = inst.control.exp;
     const IR::Attribute attrib{exp.target};
     const std::array vsrc = {
-        IR::VectorReg(inst.src[0].code),
-        IR::VectorReg(inst.src[1].code),
-        IR::VectorReg(inst.src[2].code),
-        IR::VectorReg(inst.src[3].code),
+        IR::VectorReg(inst.Src(0).code),
+        IR::VectorReg(inst.Src(1).code),
+        IR::VectorReg(inst.Src(2).code),
+        IR::VectorReg(inst.Src(3).code),
     };
 
     const auto unpack = [&](u32 idx) {
@@ -6,16 +6,16 @@
 namespace Shader::Gcn {
 
 void Translator::S_MOV(const GcnInst& inst) {
-    SetDst(inst.dst[0], GetSrc(inst.src[0]));
+    SetDst(inst.Dst(0), GetSrc(inst.Src(0)));
 }
 
 void Translator::S_MUL_I32(const GcnInst& inst) {
-    SetDst(inst.dst[0], ir.IMul(GetSrc(inst.src[0]), GetSrc(inst.src[1])));
+    SetDst(inst.Dst(0), ir.IMul(GetSrc(inst.Src(0)), GetSrc(inst.Src(1))));
 }
 
 void Translator::S_CMP(ConditionOp cond, bool is_signed, const GcnInst& inst) {
-    const IR::U32 lhs = GetSrc(inst.src[0]);
-    const IR::U32 rhs = GetSrc(inst.src[1]);
+    const IR::U32 lhs = GetSrc(inst.Src(0));
+    const IR::U32 rhs = GetSrc(inst.Src(1));
     const IR::U1 result = [&] {
         switch (cond) {
         case ConditionOp::EQ:
@@ -32,26 +32,26 @@ void Load(IR::IREmitter& ir, int num_dwords, const IR::Value& handle,
 
 void Translator::S_LOAD_DWORD(int num_dwords, const GcnInst& inst) {
     const auto& smrd = inst.control.smrd;
-    const IR::ScalarReg sbase = IR::ScalarReg(inst.src[0].code * 2);
+    const IR::ScalarReg sbase = IR::ScalarReg(inst.Src(0).code * 2);
     const IR::U32 offset = smrd.imm ? ir.Imm32(smrd.offset * 4)
                                     : IR::U32{ir.GetScalarReg(IR::ScalarReg(smrd.offset))};
     const IR::U64 base = ir.PackUint2x32(ir.CompositeConstruct(ir.GetScalarReg(sbase),
                                                                ir.GetScalarReg(sbase + 1)));
     const IR::U64 address = ir.IAdd(base, offset);
-    const IR::ScalarReg dst_reg{inst.dst[0].code};
+    const IR::ScalarReg dst_reg{inst.Dst(0).code};
     Load(ir, num_dwords, {}, dst_reg, address);
 }
 
 void Translator::S_BUFFER_LOAD_DWORD(int num_dwords, const GcnInst& inst) {
     const auto& smrd = inst.control.smrd;
-    const IR::ScalarReg sbase = IR::ScalarReg(inst.src[0].code * 2);
+    const IR::ScalarReg sbase = IR::ScalarReg(inst.Src(0).code * 2);
     const IR::U32 offset = smrd.imm ? ir.Imm32(smrd.offset)
                                     : IR::U32{ir.GetScalarReg(IR::ScalarReg(smrd.offset))};
     const IR::Value vsharp = ir.CompositeConstruct(ir.GetScalarReg(sbase),
                                                    ir.GetScalarReg(sbase + 1),
                                                    ir.GetScalarReg(sbase + 2),
                                                    ir.GetScalarReg(sbase + 3));
-    const IR::ScalarReg dst_reg{inst.dst[0].code};
+    const IR::ScalarReg dst_reg{inst.Dst(0).code};
     Load(ir, num_dwords, vsharp, dst_reg, offset);
 }
 
@@ -78,7 +78,14 @@ void Translate(IR::Block* block, std::span<const GcnInst> inst_list) {
             translator.EXP(inst);
             break;
         case Opcode::S_ENDPGM:
-            break;
+        case Opcode::S_BRANCH:
+        case Opcode::S_CBRANCH_SCC0:
+        case Opcode::S_CBRANCH_SCC1:
+        case Opcode::S_CBRANCH_VCCZ:
+        case Opcode::S_CBRANCH_VCCNZ:
+        case Opcode::S_CBRANCH_EXECZ:
+        case Opcode::S_CBRANCH_EXECNZ:
+            break; // Control flow is taken from the CFG.
         default:
             UNREACHABLE();
         }
@@ -6,18 +6,18 @@
 namespace Shader::Gcn {
 
 void Translator::V_MOV(const GcnInst& inst) {
-    SetDst(inst.dst[0], GetSrc(inst.src[0]));
+    SetDst(inst.Dst(0), GetSrc(inst.Src(0)));
 }
 
 void Translator::V_SAD(const GcnInst& inst) {
-    const IR::U32 abs_diff = ir.IAbs(ir.ISub(GetSrc(inst.src[0]),
-                                             GetSrc(inst.src[1])));
-    SetDst(inst.dst[0], ir.IAdd(abs_diff, GetSrc(inst.src[2])));
+    const IR::U32 abs_diff = ir.IAbs(ir.ISub(GetSrc(inst.Src(0)),
+                                             GetSrc(inst.Src(1))));
+    SetDst(inst.Dst(0), ir.IAdd(abs_diff, GetSrc(inst.Src(2))));
 }
 
 void Translator::V_MAC_F32(const GcnInst& inst) {
-    SetDst(inst.dst[0], ir.FPFma(GetSrc(inst.src[0]), GetSrc(inst.src[1]),
-                                 GetSrc(inst.dst[0])));
+    SetDst(inst.Dst(0), ir.FPFma(GetSrc(inst.Src(0)), GetSrc(inst.Src(1)),
+                                 GetSrc(inst.Dst(0))));
 }
 
 } // namespace Shader::Gcn
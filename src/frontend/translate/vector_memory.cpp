@@ -6,10 +6,10 @@
 namespace Shader::Gcn {
 
 void Translator::IMAGE_GET_RESINFO(const GcnInst& inst) {
-    IR::VectorReg dst_reg{inst.src[1].code};
-    const IR::ScalarReg tsharp_reg{inst.src[2].code};
+    IR::VectorReg dst_reg{inst.Src(1).code};
+    const IR::ScalarReg tsharp_reg{inst.Src(2).code};
     const auto flags = ImageResFlags(inst.control.mimg.dmask);
-    const IR::U32 lod = ir.GetVectorReg(IR::VectorReg(inst.src[0].code));
+    const IR::U32 lod = ir.GetVectorReg(IR::VectorReg(inst.Src(0).code));
     const IR::Value tsharp = ir.CompositeConstruct(ir.GetScalarReg(tsharp_reg),
                                                    ir.GetScalarReg(tsharp_reg + 1),
                                                    ir.GetScalarReg(tsharp_reg + 2),
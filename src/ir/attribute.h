@@ -56,6 +56,7 @@ enum class Attribute : u64 {
     Param30 = 62,
     Param31 = 63,
 };
+constexpr size_t NumAttributes = static_cast<size_t>(Attribute::Param31) + 1;
 
 constexpr size_t EXP_NUM_POS = 4;
 constexpr size_t EXP_NUM_PARAM = 32;
@@ -3,13 +3,12 @@
 
 #include <algorithm>
 #include <initializer_list>
-#include <map>
 #include "ir/basic_block.h"
 #include "ir/value.h"
 
 namespace Shader::IR {
 
-Block::Block(ObjectPool<Inst>& inst_pool_) : inst_pool{&inst_pool_} {}
+Block::Block(InstPool& inst_pool_) : inst_pool{&inst_pool_} {}
 
 Block::~Block() = default;
 
@@ -27,9 +26,9 @@ Block::iterator Block::PrependNewInst(iterator insertion_point, Opcode op,
     Inst* const inst{inst_pool->Create(op, flags)};
     const auto result_it{instructions.insert(insertion_point, *inst)};
 
-    if (inst->NumArgs() != args.size()) {
-        throw InvalidArgument("Invalid number of arguments {} in {}", args.size(), op);
-    }
+    // Slots are sized by the opcode, extra arguments would overwrite the next instruction
+    ASSERT_MSG(inst->NumArgs() == args.size(), "Invalid number of arguments {} in {}",
+               args.size(), op);
     std::ranges::for_each(args, [inst, index = size_t{0}](const Value& arg) mutable {
         inst->SetArg(index, arg);
         ++index;
@@ -48,29 +47,36 @@ void Block::AddBranch(Block* block) {
     block->imm_predecessors.push_back(this);
 }
 
-static std::string BlockToIndex(const std::map<const Block*, size_t>& block_to_index,
+void Block::SetBranches(std::span<Block* const> predecessors,
+                        std::span<Block* const> successors) {
+    imm_predecessors.assign(predecessors.begin(), predecessors.end());
+    imm_successors.assign(successors.begin(), successors.end());
+}
+
+static std::string BlockToIndex(const SideTable<Block, std::optional<size_t>>& block_to_index,
                                 Block* block) {
-    if (const auto it{block_to_index.find(block)}; it != block_to_index.end()) {
-        return fmt::format("{{Block ${}}}", it->second);
+    if (const auto& index{block_to_index.Get(block)}) {
+        return fmt::format("{{Block ${}}}", *index);
     }
-    return fmt::format("$<unknown block {:016x}>", reinterpret_cast<u64>(block));
+    return fmt::format("$<unknown block {}>", block->Index());
 }
 
-static size_t InstIndex(std::map<const Inst*, size_t>& inst_to_index, size_t& inst_index,
+static size_t InstIndex(SideTable<Inst, size_t>& inst_to_index, size_t& inst_index,
                         const Inst* inst) {
-    const auto [it, is_inserted]{inst_to_index.emplace(inst, inst_index + 1)};
-    if (is_inserted) {
-        ++inst_index;
+    // Numbers start at one, so zero marks instructions not numbered yet.
+    size_t& index{inst_to_index[inst]};
+    if (index == 0) {
+        index = ++inst_index;
     }
-    return it->second;
+    return index;
 }
 
-static std::string ArgToIndex(std::map<const Inst*, size_t>& inst_to_index, size_t& inst_index,
+static std::string ArgToIndex(SideTable<Inst, size_t>& inst_to_index, size_t& inst_index,
                               const Value& arg) {
     if (arg.IsEmpty()) {
         return "<null>";
     }
-    if (!arg.IsImmediate() || arg.IsIdentity()) {
+    if (!arg.IsImmediate()) {
         return fmt::format("%{}", InstIndex(inst_to_index, inst_index, arg.Inst()));
     }
     switch (arg.Type()) {
@@ -99,20 +105,20 @@ static std::string ArgToIndex(std::map<const Inst*, size_t>& inst_to_index, size
 
 std::string DumpBlock(const Block& block) {
     size_t inst_index{0};
-    std::map<const Inst*, size_t> inst_to_index;
+    SideTable<Inst, size_t> inst_to_index;
     return DumpBlock(block, {}, inst_to_index, inst_index);
 }
 
-std::string DumpBlock(const Block& block, const std::map<const Block*, size_t>& block_to_index,
-                      std::map<const Inst*, size_t>& inst_to_index, size_t& inst_index) {
+std::string DumpBlock(const Block& block,
+                      const SideTable<Block, std::optional<size_t>>& block_to_index,
+                      SideTable<Inst, size_t>& inst_to_index, size_t& inst_index) {
     std::string ret{"Block"};
-    if (const auto it{block_to_index.find(&block)}; it != block_to_index.end()) {
-        ret += fmt::format(" ${}", it->second);
+    if (const auto& index{block_to_index.Get(&block)}) {
+        ret += fmt::format(" ${}", *index);
     }
     ret += '\n';
     for (const Inst& inst : block) {
         const Opcode op{inst.GetOpcode()};
-        ret += fmt::format("[{:016x}] ", reinterpret_cast<u64>(&inst));
         if (TypeOf(op) != Type::Void) {
             ret += fmt::format("%{:<5} = {}", InstIndex(inst_to_index, inst_index, &inst), op);
         } else {
@@ -4,14 +4,15 @@
 #pragma once
 
 #include <initializer_list>
-#include <map>
+#include <optional>
 #include <span>
 #include <vector>
 #include <boost/intrusive/list.hpp>
 
 #include "common/types.h"
+#include "ir/inst_pool.h"
 #include "ir/value.h"
-#include "ir/reg.h"
+#include "ir/side_table.h"
 #include "object_pool.h"
 
 namespace Shader::IR {
@@ -25,7 +26,7 @@ public:
     using reverse_iterator = InstructionList::reverse_iterator;
     using const_reverse_iterator = InstructionList::const_reverse_iterator;
 
-    explicit Block(ObjectPool<Inst>& inst_pool_);
+    explicit Block(InstPool& inst_pool_);
     ~Block();
 
     Block(const Block&) = delete;
@@ -44,9 +45,22 @@ public:
     iterator PrependNewInst(iterator insertion_point, Opcode op,
                             std::initializer_list<Value> args = {}, u32 flags = 0);
 
+    /// Dense index of this block, given by the pool that created it. Stable for the lifetime
+    /// of the block and usable as a key of SideTable and IndexSet.
+    [[nodiscard]] u32 Index() const noexcept {
+        return index;
+    }
+    void SetPoolIndex(u32 index_) noexcept {
+        index = index_;
+    }
+
     /// Adds a new branch to this basic block.
     void AddBranch(Block* block);
 
+    /// Replaces the immediate predecessors and successors of this block, keeping their order.
+    /// Phi operands follow the order of the predecessors, so copies of a block must keep it.
+    void SetBranches(std::span<Block* const> predecessors, std::span<Block* const> successors);
+
     /// Gets a mutable reference to the instruction list for this basic block.
     [[nodiscard]] InstructionList& Instructions() noexcept {
         return instructions;
@@ -56,6 +70,11 @@ public:
         return instructions;
     }
 
+    /// Gets the pool that creates the instructions of this basic block.
+    [[nodiscard]] InstPool& InstructionPool() const noexcept {
+        return *inst_pool;
+    }
+
     /// Gets an immutable span to the immediate predecessors.
     [[nodiscard]] std::span<Block* const> ImmPredecessors() const noexcept {
         return imm_predecessors;
@@ -145,13 +164,9 @@ public:
         return instructions.crend();
     }
 
-    /// Intrusively store the value of a register in the block.
-    std::array<Value, NumScalarRegs> ssa_sreg_values;
-    std::array<Value, NumVectorRegs> ssa_vreg_values;
-
 private:
     /// Memory pool for instruction list
-    ObjectPool<Inst>* inst_pool;
+    InstPool* inst_pool;
 
     /// List of instructions in this block
     InstructionList instructions;
@@ -166,6 +181,9 @@ private:
 
     /// Intrusively stored host definition of this block.
     u32 definition{};
+
+    /// Index given by the block pool.
+    u32 index{};
 };
 
 using BlockList = std::vector<Block*>;
@@ -173,8 +191,7 @@ using BlockList = std::vector<Block*>;
 [[nodiscard]] std::string DumpBlock(const Block& block);
 
 [[nodiscard]] std::string DumpBlock(const Block& block,
-                                    const std::map<const Block*, size_t>& block_to_index,
-                                    std::map<const Inst*, size_t>& inst_to_index,
-                                    size_t& inst_index);
+                                    const SideTable<Block, std::optional<size_t>>& block_to_index,
+                                    SideTable<Inst, size_t>& inst_to_index, size_t& inst_index);
 
 } // namespace Shader::IR
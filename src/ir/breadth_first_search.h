@@ -21,7 +21,7 @@ auto BreadthFirstSearch(const Value& value, Pred&& pred)
     // Breadth-first search visiting the right most arguments first
     boost::container::small_vector<const Inst*, 2> visited;
     std::queue<const Inst*> queue;
-    queue.push(value.InstRecursive());
+    queue.push(value.Inst());
 
     while (!queue.empty()) {
         // Pop one instruction from the queue
@@ -38,7 +38,7 @@ auto BreadthFirstSearch(const Value& value, Pred&& pred)
                 continue;
             }
             // Queue instruction if it hasn't been visited
-            const Inst* const arg_inst{arg_value.InstRecursive()};
+            const Inst* const arg_inst{arg_value.Inst()};
             if (std::ranges::find(visited, arg_inst) == visited.end()) {
                 visited.push_back(arg_inst);
                 queue.push(arg_inst);
@@ -0,0 +1,327 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <boost/container/small_vector.hpp>
+#include "common/assert.h"
+#include "ir/dominance.h"
+
+namespace Shader::IR {
+
+namespace {
+
+/// Sorts the edges by key into compressed arrays, keeping their relative order.
+template <typename Key, typename Value>
+void BuildCompressed(u32 num_nodes, std::span<const std::pair<NodeIndex, NodeIndex>> edges,
+                     Key&& key, Value&& value, std::vector<u32>& offsets,
+                     std::vector<NodeIndex>& targets) {
+    offsets.assign(num_nodes + 1, 0);
+    for (const auto& edge : edges) {
+        ++offsets[key(edge) + 1];
+    }
+    for (u32 node = 0; node < num_nodes; ++node) {
+        offsets[node + 1] += offsets[node];
+    }
+    targets.resize(edges.size());
+    std::vector<u32> cursor(offsets.begin(), offsets.end() - 1);
+    for (const auto& edge : edges) {
+        targets[cursor[key(edge)]++] = value(edge);
+    }
+}
+
+} // Anonymous namespace
+
+FlowGraph::FlowGraph(u32 num_nodes, NodeIndex entry_,
+                     std::span<const std::pair<NodeIndex, NodeIndex>> edges)
+    : entry{entry_} {
+    ASSERT(num_nodes == 0 || entry < num_nodes);
+    const auto from = [](const auto& edge) { return edge.first; };
+    const auto to = [](const auto& edge) { return edge.second; };
+    BuildCompressed(num_nodes, edges, from, to, succ_offsets, succs);
+    BuildCompressed(num_nodes, edges, to, from, pred_offsets, preds);
+}
+
+FlowGraph FlowGraph::Reverse() const {
+    const u32 num_nodes = NumNodes();
+    const NodeIndex exit = num_nodes;
+    std::vector<std::pair<NodeIndex, NodeIndex>> edges;
+    edges.reserve(succs.size() + num_nodes);
+    for (NodeIndex node = 0; node < num_nodes; ++node) {
+        const auto node_succs = Successors(node);
+        if (node_succs.empty()) {
+            edges.emplace_back(exit, node);
+        }
+        for (const NodeIndex succ : node_succs) {
+            edges.emplace_back(succ, node);
+        }
+    }
+    return FlowGraph(num_nodes + 1, exit, edges);
+}
+
+std::vector<NodeIndex> FlowGraph::ReversePostOrder() const {
+    std::vector<NodeIndex> order;
+    if (NumNodes() == 0) {
+        return order;
+    }
+    order.reserve(NumNodes());
+    std::vector<bool> visited(NumNodes());
+    // Each entry holds a node and the index of the next successor to visit.
+    boost::container::small_vector<std::pair<NodeIndex, u32>, 32> stack;
+    stack.emplace_back(entry, 0);
+    visited[entry] = true;
+    while (!stack.empty()) {
+        auto& [node, next] = stack.back();
+        const auto node_succs = Successors(node);
+        if (next == node_succs.size()) {
+            order.push_back(node);
+            stack.pop_back();
+            continue;
+        }
+        const NodeIndex succ = node_succs[next++];
+        if (!visited[succ]) {
+            visited[succ] = true;
+            stack.emplace_back(succ, 0);
+        }
+    }
+    std::ranges::reverse(order);
+    return order;
+}
+
+DominatorTree::DominatorTree(const FlowGraph& graph) : rpo{graph.ReversePostOrder()} {
+    const u32 num_nodes = graph.NumNodes();
+    idoms.assign(num_nodes, InvalidNode);
+    frontiers.resize(num_nodes);
+    child_offsets.assign(num_nodes + 1, 0);
+    pre_order.assign(num_nodes, 0);
+    post_order.assign(num_nodes, 0);
+    if (rpo.empty()) {
+        return;
+    }
+
+    std::vector<u32> rpo_number(num_nodes, InvalidNode);
+    for (u32 i = 0; i < rpo.size(); ++i) {
+        rpo_number[rpo[i]] = i;
+    }
+    const auto intersect = [&](NodeIndex a, NodeIndex b) {
+        while (a != b) {
+            while (rpo_number[a] > rpo_number[b]) {
+                a = idoms[a];
+            }
+            while (rpo_number[b] > rpo_number[a]) {
+                b = idoms[b];
+            }
+        }
+        return a;
+    };
+
+    const NodeIndex root = rpo.front();
+    idoms[root] = root;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (u32 i = 1; i < rpo.size(); ++i) {
+            const NodeIndex node = rpo[i];
+            NodeIndex new_idom = InvalidNode;
+            for (const NodeIndex pred : graph.Predecessors(node)) {
+                if (idoms[pred] == InvalidNode) {
+                    // Not processed yet or unreachable
+                    continue;
+                }
+                new_idom = new_idom == InvalidNode ? pred : intersect(pred, new_idom);
+            }
+            if (idoms[node] != new_idom) {
+                idoms[node] = new_idom;
+                changed = true;
+            }
+        }
+    }
+
+    // Lay out the tree in compressed form, children in reverse post order.
+    for (const NodeIndex node : rpo) {
+        if (node != root) {
+            ++child_offsets[idoms[node] + 1];
+        }
+    }
+    for (u32 node = 0; node < num_nodes; ++node) {
+        child_offsets[node + 1] += child_offsets[node];
+    }
+    children.resize(rpo.size() - 1);
+    std::vector<u32> cursor(child_offsets.begin(), child_offsets.end() - 1);
+    for (const NodeIndex node : rpo) {
+        if (node != root) {
+            children[cursor[idoms[node]]++] = node;
+        }
+    }
+
+    // Number the tree so dominance is an interval check.
+    u32 counter = 0;
+    boost::container::small_vector<std::pair<NodeIndex, u32>, 32> stack;
+    stack.emplace_back(root, 0);
+    pre_order[root] = counter++;
+    while (!stack.empty()) {
+        auto& [node, next] = stack.back();
+        const auto node_children = Children(node);
+        if (next == node_children.size()) {
+            post_order[node] = counter++;
+            stack.pop_back();
+            continue;
+        }
+        const NodeIndex child = node_children[next++];
+        pre_order[child] = counter++;
+        stack.emplace_back(child, 0);
+    }
+
+    // Dominance frontiers, walking up from the predecessors of every join node.
+    // The root is also entered from outside the graph, so any edge to it makes it a join.
+    for (const NodeIndex node : rpo) {
+        const auto node_preds = graph.Predecessors(node);
+        const bool is_root = node == root;
+        if (node_preds.size() < (is_root ? 1U : 2U)) {
+            continue;
+        }
+        for (const NodeIndex pred : node_preds) {
+            NodeIndex runner = pred;
+            while (IsReachable(runner) && (is_root || runner != idoms[node])) {
+                auto& frontier = frontiers[runner];
+                if (frontier.empty() || frontier.back() != node) {
+                    frontier.push_back(node);
+                }
+                if (runner == root) {
+                    break;
+                }
+                runner = idoms[runner];
+            }
+        }
+    }
+}
+
+LoopForest::LoopForest(const FlowGraph& graph, const DominatorTree& dom_tree) {
+    const u32 num_nodes = graph.NumNodes();
+    loop_of.assign(num_nodes, InvalidLoop);
+
+    // Outermost loop found so far around each loop. Lookups halve the paths they walk, so
+    // deep nests are not walked once per enclosing loop.
+    std::vector<LoopIndex> outer;
+    const auto outermost = [&outer](LoopIndex loop) {
+        while (outer[loop] != loop) {
+            outer[loop] = outer[outer[loop]];
+            loop = outer[loop];
+        }
+        return loop;
+    };
+
+    // Inner headers are dominated by outer ones and come later in reverse post order,
+    // so visiting headers backwards discovers inner loops first.
+    const auto rpo = dom_tree.ReversePostOrder();
+    boost::container::small_vector<NodeIndex, 32> worklist;
+    for (auto it = rpo.rbegin(); it != rpo.rend(); ++it) {
+        const NodeIndex header = *it;
+        std::vector<NodeIndex> latches;
+        for (const NodeIndex pred : graph.Predecessors(header)) {
+            if (dom_tree.Dominates(header, pred)) {
+                latches.push_back(pred);
+            }
+        }
+        if (latches.empty()) {
+            continue;
+        }
+        const LoopIndex loop = static_cast<LoopIndex>(loops.size());
+        loops.push_back(Loop{
+            .header = header,
+            .parent = InvalidLoop,
+            .depth = 1,
+            .latches = std::move(latches),
+            .order_begin = 0,
+            .order_end = 0,
+        });
+        outer.push_back(loop);
+        loop_of[header] = loop;
+
+        // Walk backwards from the latches up to the header.
+        worklist.assign(loops[loop].latches.begin(), loops[loop].latches.end());
+        while (!worklist.empty()) {
+            const NodeIndex node = worklist.back();
+            worklist.pop_back();
+            NodeIndex pred_source = node;
+            if (loop_of[node] == InvalidLoop) {
+                loop_of[node] = loop;
+            } else {
+                const LoopIndex inner = outermost(loop_of[node]);
+                if (inner == loop) {
+                    continue;
+                }
+                // Nest the inner loop and continue from its header.
+                loops[inner].parent = loop;
+                outer[inner] = loop;
+                pred_source = loops[inner].header;
+            }
+            for (const NodeIndex pred : graph.Predecessors(pred_source)) {
+                if (dom_tree.IsReachable(pred)) {
+                    worklist.push_back(pred);
+                }
+            }
+        }
+    }
+
+    // Parents are created after their children. Walk forwards to size the subtrees, then
+    // backwards to compute depths and number the tree, so containment is an interval check.
+    std::vector<u32> subtree_sizes(loops.size(), 1);
+    for (LoopIndex loop = 0; loop < loops.size(); ++loop) {
+        if (const LoopIndex parent = loops[loop].parent; parent != InvalidLoop) {
+            subtree_sizes[parent] += subtree_sizes[loop];
+        }
+    }
+    std::vector<u32> next_order(loops.size());
+    u32 num_ordered = 0;
+    for (LoopIndex loop = static_cast<LoopIndex>(loops.size()); loop-- > 0;) {
+        const LoopIndex parent = loops[loop].parent;
+        u32& order = parent == InvalidLoop ? num_ordered : next_order[parent];
+        loops[loop].depth = parent == InvalidLoop ? 1 : loops[parent].depth + 1;
+        loops[loop].order_begin = order;
+        loops[loop].order_end = order + subtree_sizes[loop];
+        next_order[loop] = order + 1;
+        order += subtree_sizes[loop];
+    }
+
+    // A retreating edge of a depth first search whose target does not dominate its source
+    // enters a cycle from the side.
+    if (rpo.empty()) {
+        return;
+    }
+    std::vector<u8> state(num_nodes); // 0 unvisited, 1 on stack, 2 done
+    boost::container::small_vector<std::pair<NodeIndex, u32>, 32> stack;
+    stack.emplace_back(graph.Entry(), 0);
+    state[graph.Entry()] = 1;
+    while (!stack.empty()) {
+        auto& [node, next] = stack.back();
+        const auto node_succs = graph.Successors(node);
+        if (next == node_succs.size()) {
+            state[node] = 2;
+            stack.pop_back();
+            continue;
+        }
+        const NodeIndex succ = node_succs[next++];
+        if (state[succ] == 0) {
+            state[succ] = 1;
+            stack.emplace_back(succ, 0);
+        } else if (state[succ] == 1 && !dom_tree.Dominates(succ, node)) {
+            is_reducible = false;
+        }
+    }
+}
+
+const DominatorTree& FlowAnalysis::Dominators() {
+    if (!dom_tree) {
+        dom_tree.emplace(graph);
+    }
+    return *dom_tree;
+}
+
+const LoopForest& FlowAnalysis::Loops() {
+    if (!loop_forest) {
+        loop_forest.emplace(graph, Dominators());
+    }
+    return *loop_forest;
+}
+
+} // namespace Shader::IR
@@ -0,0 +1,188 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "common/types.h"
+
+namespace Shader::IR {
+
+/// Dense index of a node in a FlowGraph.
+using NodeIndex = u32;
+constexpr NodeIndex InvalidNode = std::numeric_limits<NodeIndex>::max();
+
+/// Control flow graph over dense node indices, with edges stored in compressed arrays.
+/// Gcn::CFG is lowered to it before the analyses below run.
+class FlowGraph {
+public:
+    FlowGraph() = default;
+
+    /// Builds a graph of num_nodes nodes from a list of (from, to) edges.
+    explicit FlowGraph(u32 num_nodes, NodeIndex entry,
+                       std::span<const std::pair<NodeIndex, NodeIndex>> edges);
+
+    /// Returns the graph with every edge reversed and a virtual exit node with index NumNodes()
+    /// as entry. The virtual exit has an edge to every node without successors.
+    [[nodiscard]] FlowGraph Reverse() const;
+
+    [[nodiscard]] u32 NumNodes() const noexcept {
+        return static_cast<u32>(succ_offsets.size()) - 1;
+    }
+    [[nodiscard]] NodeIndex Entry() const noexcept {
+        return entry;
+    }
+    [[nodiscard]] std::span<const NodeIndex> Successors(NodeIndex node) const noexcept {
+        return {succs.data() + succ_offsets[node], succs.data() + succ_offsets[node + 1]};
+    }
+    [[nodiscard]] std::span<const NodeIndex> Predecessors(NodeIndex node) const noexcept {
+        return {preds.data() + pred_offsets[node], preds.data() + pred_offsets[node + 1]};
+    }
+
+    /// Nodes reachable from the entry in reverse post order.
+    [[nodiscard]] std::vector<NodeIndex> ReversePostOrder() const;
+
+private:
+    NodeIndex entry = 0;
+    std::vector<u32> succ_offsets{0};
+    std::vector<NodeIndex> succs;
+    std::vector<u32> pred_offsets{0};
+    std::vector<NodeIndex> preds;
+};
+
+/**
+ * Dominator tree computed with the iterative algorithm from:
+ * A Simple, Fast Dominance Algorithm.
+ * Keith D. Cooper, Timothy J. Harvey and Ken Kennedy
+ * https://www.cs.rice.edu/~keith/EMBED/dom.pdf
+ * Build it on FlowGraph::Reverse() to get post-dominators.
+ */
+class DominatorTree {
+public:
+    explicit DominatorTree(const FlowGraph& graph);
+
+    /// Returns the immediate dominator of node. The root is its own immediate dominator,
+    /// nodes that are not reachable from the root have none.
+    [[nodiscard]] NodeIndex ImmediateDominator(NodeIndex node) const noexcept {
+        return idoms[node];
+    }
+
+    [[nodiscard]] bool IsReachable(NodeIndex node) const noexcept {
+        return idoms[node] != InvalidNode;
+    }
+
+    /// Returns true if every path from the root to b goes through a. Constant time.
+    [[nodiscard]] bool Dominates(NodeIndex a, NodeIndex b) const noexcept {
+        return IsReachable(a) && IsReachable(b) && pre_order[a] <= pre_order[b] &&
+               post_order[b] <= post_order[a];
+    }
+
+    [[nodiscard]] bool StrictlyDominates(NodeIndex a, NodeIndex b) const noexcept {
+        return a != b && Dominates(a, b);
+    }
+
+    /// Returns the nodes immediately dominated by node.
+    [[nodiscard]] std::span<const NodeIndex> Children(NodeIndex node) const noexcept {
+        return {children.data() + child_offsets[node], children.data() + child_offsets[node + 1]};
+    }
+
+    /// Returns the dominance frontier of node.
+    [[nodiscard]] std::span<const NodeIndex> Frontier(NodeIndex node) const noexcept {
+        return frontiers[node];
+    }
+
+    /// Returns the reachable nodes in reverse post order of the flow graph.
+    [[nodiscard]] std::span<const NodeIndex> ReversePostOrder() const noexcept {
+        return rpo;
+    }
+
+private:
+    std::vector<NodeIndex> rpo;
+    std::vector<NodeIndex> idoms;
+    std::vector<u32> child_offsets;
+    std::vector<NodeIndex> children;
+    std::vector<u32> pre_order;
+    std::vector<u32> post_order;
+    std::vector<std::vector<NodeIndex>> frontiers;
+};
+
+/// Index of a loop in a LoopForest.
+using LoopIndex = u32;
+constexpr LoopIndex InvalidLoop = std::numeric_limits<LoopIndex>::max();
+
+struct Loop {
+    NodeIndex header;
+    LoopIndex parent = InvalidLoop; ///< Innermost loop containing this one.
+    u32 depth = 1;                  ///< Number of loops containing the header, this one included.
+    std::vector<NodeIndex> latches; ///< Sources of the back edges to the header.
+    u32 order_begin = 0;            ///< Pre order number of the loop in the loop tree.
+    u32 order_end = 0;              ///< One past the numbers of the loops nested in this one.
+};
+
+/// Natural loops of a flow graph, nested by containment.
+class LoopForest {
+public:
+    explicit LoopForest(const FlowGraph& graph, const DominatorTree& dom_tree);
+
+    [[nodiscard]] std::span<const Loop> Loops() const noexcept {
+        return loops;
+    }
+
+    /// Returns the innermost loop containing node.
+    [[nodiscard]] LoopIndex LoopOf(NodeIndex node) const noexcept {
+        return loop_of[node];
+    }
+
+    /// Returns the number of loops containing node.
+    [[nodiscard]] u32 Depth(NodeIndex node) const noexcept {
+        return loop_of[node] == InvalidLoop ? 0 : loops[loop_of[node]].depth;
+    }
+
+    /// Returns true if node is part of loop, nested loops included. Constant time.
+    [[nodiscard]] bool Contains(LoopIndex loop, NodeIndex node) const noexcept {
+        const LoopIndex inner = loop_of[node];
+        return inner != InvalidLoop && loops[loop].order_begin <= loops[inner].order_begin &&
+               loops[inner].order_begin < loops[loop].order_end;
+    }
+
+    [[nodiscard]] bool IsHeader(NodeIndex node) const noexcept {
+        return loop_of[node] != InvalidLoop && loops[loop_of[node]].header == node;
+    }
+
+    /// Returns false if a cycle is entered other than through a node that dominates it.
+    /// Such cycles are not natural loops and are missing from the forest.
+    [[nodiscard]] bool IsReducible() const noexcept {
+        return is_reducible;
+    }
+
+private:
+    std::vector<Loop> loops;
+    std::vector<LoopIndex> loop_of;
+    bool is_reducible = true;
+};
+
+/// Dominance and loop information of a flow graph. Every analysis is computed on first use
+/// and kept until the owner of the graph changes its edges and discards this object.
+class FlowAnalysis {
+public:
+    explicit FlowAnalysis(FlowGraph graph_) : graph{std::move(graph_)} {}
+
+    [[nodiscard]] const FlowGraph& Graph() const noexcept {
+        return graph;
+    }
+
+    [[nodiscard]] const DominatorTree& Dominators();
+    [[nodiscard]] const LoopForest& Loops();
+
+private:
+    FlowGraph graph;
+    std::optional<DominatorTree> dom_tree;
+    std::optional<LoopForest> loop_forest;
+};
+
+} // namespace Shader::IR
@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <bit>
+#include <new>
+#include "common/assert.h"
+#include "ir/inst_pool.h"
+
+namespace Shader::IR {
+
+InstPool::InstPool(size_t chunk_size) : new_chunk_size{chunk_size} {}
+
+InstPool::~InstPool() = default;
+
+void* InstPool::Allocate(size_t size) {
+    static_assert(alignof(Inst) <= alignof(std::max_align_t));
+    size = (size + alignof(Inst) - 1) & ~(alignof(Inst) - 1);
+    if (chunks.empty() || used_bytes + size > chunks.back().size) {
+        const size_t chunk_size{std::max(new_chunk_size, size)};
+        chunks.push_back(Chunk{std::make_unique<std::byte[]>(chunk_size), chunk_size});
+        used_bytes = 0;
+    }
+    void* const memory{chunks.back().memory.get() + used_bytes};
+    used_bytes += size;
+    return memory;
+}
+
+Inst* InstPool::Create(Opcode op, u32 flags) {
+    void* const memory{Allocate(sizeof(Inst) + Inst::NumSlotsOf(op) * sizeof(Use))};
+    Inst* const inst{new (memory) Inst(op, flags, *this)};
+    inst->SetPoolIndex(static_cast<u32>(num_created++));
+    return inst;
+}
+
+Inst* InstPool::Create(const Inst& base) {
+    void* const memory{Allocate(sizeof(Inst) + Inst::NumSlotsOf(base.op) * sizeof(Use))};
+    Inst* const inst{new (memory) Inst(base, *this)};
+    inst->SetPoolIndex(static_cast<u32>(num_created++));
+    return inst;
+}
+
+PhiOperand* InstPool::AllocatePhiOperands(u32 capacity) {
+    DEBUG_ASSERT(std::has_single_bit(capacity));
+    auto& free_list{free_phi_operands[std::countr_zero(capacity)]};
+    if (!free_list.empty()) {
+        PhiOperand* const operands{free_list.back()};
+        free_list.pop_back();
+        return operands;
+    }
+    return static_cast<PhiOperand*>(Allocate(capacity * sizeof(PhiOperand)));
+}
+
+void InstPool::FreePhiOperands(PhiOperand* operands, u32 capacity) {
+    DEBUG_ASSERT(std::has_single_bit(capacity));
+    free_phi_operands[std::countr_zero(capacity)].push_back(operands);
+}
+
+const u64* InstPool::InternImmediate(u64 bits) {
+    const auto [it, is_inserted]{immediates.try_emplace(bits)};
+    if (is_inserted) {
+        it->second = new (Allocate(sizeof(u64))) u64{bits};
+    }
+    return it->second;
+}
+
+void InstPool::ReleaseContents() {
+    // Instructions and operands are trivially released, keep the first chunk for reuse.
+    if (chunks.size() > 1) {
+        chunks.resize(1);
+    }
+    used_bytes = 0;
+    num_created = 0;
+    for (auto& free_list : free_phi_operands) {
+        free_list.clear();
+    }
+    immediates.clear();
+}
+
+size_t InstPool::MemoryUsage() const noexcept {
+    size_t size{};
+    for (const Chunk& chunk : chunks) {
+        size += chunk.size;
+    }
+    return size;
+}
+
+} // namespace Shader::IR
@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "common/types.h"
+#include "ir/opcodes.h"
+#include "ir/value.h"
+
+namespace Shader::IR {
+
+/// Memory pool of instructions. Every instruction is allocated together with the argument
+/// slots its opcode needs, so its footprint follows the opcode instead of the widest one.
+/// Phi operands live in power of two segments of the same memory; a segment outgrown by its
+/// phi is kept in a free list for the next phi of that size. 64-bit immediates too wide for a
+/// Value are stored once per pool as well. Nothing is freed or destroyed before ReleaseContents.
+class InstPool {
+public:
+    explicit InstPool(size_t chunk_size = 16_KB);
+    ~InstPool();
+
+    InstPool(const InstPool&) = delete;
+    InstPool& operator=(const InstPool&) = delete;
+
+    /// Creates an instruction without arguments set.
+    [[nodiscard]] Inst* Create(Opcode op, u32 flags = 0);
+
+    /// Creates a copy of an instruction that uses the same arguments.
+    [[nodiscard]] Inst* Create(const Inst& base);
+
+    /// Returns a segment for capacity phi operands. Capacity must be a power of two.
+    [[nodiscard]] PhiOperand* AllocatePhiOperands(u32 capacity);
+
+    /// Makes a segment returned by AllocatePhiOperands available again.
+    void FreePhiOperands(PhiOperand* operands, u32 capacity);
+
+    /// Returns storage holding bits, shared by every request for the same bits until release.
+    [[nodiscard]] const u64* InternImmediate(u64 bits);
+
+    /// Releases every instruction created so far and restarts their numbering.
+    void ReleaseContents();
+
+    /// Returns the number of instructions created since the last release.
+    [[nodiscard]] size_t NumObjects() const noexcept {
+        return num_created;
+    }
+
+    /// Returns the number of bytes held by the pool, used or not.
+    [[nodiscard]] size_t MemoryUsage() const noexcept;
+
+private:
+    struct Chunk {
+        std::unique_ptr<std::byte[]> memory;
+        size_t size;
+    };
+
+    [[nodiscard]] void* Allocate(size_t size);
+
+    std::vector<Chunk> chunks;
+    size_t used_bytes{};
+    size_t new_chunk_size{};
+    size_t num_created{};
+    std::array<std::vector<PhiOperand*>, 32> free_phi_operands;
+    std::unordered_map<u64, const u64*> immediates;
+};
+
+} // namespace Shader::IR
@@ -38,15 +38,15 @@ F32 IREmitter::Imm32(f32 value) const {
 }
 
 U64 IREmitter::Imm64(u64 value) const {
-    return U64{Value{value}};
+    return U64{Value{value, block->InstructionPool()}};
 }
 
 U64 IREmitter::Imm64(s64 value) const {
-    return U64{Value{static_cast<u64>(value)}};
+    return U64{Value{static_cast<u64>(value), block->InstructionPool()}};
 }
 
 F64 IREmitter::Imm64(f64 value) const {
-    return F64{Value{value}};
+    return F64{Value{value, block->InstructionPool()}};
 }
 
 U1 IREmitter::ConditionRef(const U1& value) {
@@ -2,42 +2,60 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <bit>
 #include <memory>
 
 #include "exception.h"
 #include "ir/basic_block.h"
+#include "ir/inst_pool.h"
 #include "ir/type.h"
 #include "ir/value.h"
 
 namespace Shader::IR {
 
-Inst::Inst(IR::Opcode op_, u32 flags_) noexcept : op{op_}, flags{flags_} {
+namespace {
+
+/// Phi operand segments hold a power of two operands, at least two. Empty phis have none.
+u32 PhiCapacity(u32 num_operands) {
+    return num_operands == 0 ? 0 : std::bit_ceil(std::max<u32>(num_operands, 2));
+}
+
+/// Moves a use to another slot, keeping its place in the use list of its value.
+void MoveUse(Use& from, Use& to) noexcept {
+    to = from;
+    if (!to.value.IsImmediate()) {
+        *to.prev = &to;
+        if (to.next) {
+            to.next->prev = &to.next;
+        }
+    }
+}
+
+} // Anonymous namespace
+
+Inst::Inst(IR::Opcode op_, u32 flags_, InstPool& pool) noexcept : op{op_}, flags{flags_} {
     if (op == Opcode::Phi) {
-        std::construct_at(&phi_args);
+        num_phi_args = 0;
+        std::construct_at(&PhiData(), PhiStorage{.operands = nullptr, .pool = &pool});
     } else {
-        std::construct_at(&args);
+        num_slots = NumSlotsOf(op);
+        InitSlots();
     }
 }
 
-Inst::Inst(const Inst& base) : op{base.op}, flags{base.flags} {
+Inst::Inst(const Inst& base, InstPool& pool) : Inst{base.op, base.flags, pool} {
+    const size_t num_args{base.NumArgs()};
     if (base.op == Opcode::Phi) {
-        throw NotImplementedException("Copying phi node");
+        for (size_t index = 0; index < num_args; ++index) {
+            AddPhiOperand(base.PhiBlock(index), base.Arg(index));
+        }
+        return;
     }
-    std::construct_at(&args);
-    const size_t num_args{base.NumArgs()};
     for (size_t index = 0; index < num_args; ++index) {
         SetArg(index, base.Arg(index));
     }
 }
 
-Inst::~Inst() {
-    if (op == Opcode::Phi) {
-        std::destroy_at(&phi_args);
-    } else {
-        std::destroy_at(&args);
-    }
-}
-
 bool Inst::MayHaveSideEffects() const noexcept {
     switch (op) {
     case Opcode::ConditionRef:
@@ -64,8 +82,8 @@ bool Inst::AreAllArgsImmediates() const {
     if (op == Opcode::Phi) {
         throw LogicError("Testing for all arguments are immediates on phi instruction");
     }
-    return std::all_of(args.begin(), args.begin() + NumArgs(),
-                       [](const IR::Value& value) { return value.IsImmediate(); });
+    return std::all_of(Slots(), Slots() + NumArgs(),
+                       [](const IR::Use& use) { return use.value.IsImmediate(); });
 }
 
 IR::Type Inst::Type() const {
@@ -73,38 +91,40 @@ IR::Type Inst::Type() const {
 }
 
 void Inst::SetArg(size_t index, Value value) {
-    if (index >= NumArgs()) {
-        throw InvalidArgument("Out of bounds argument index {} in opcode {}", index, op);
-    }
-    const IR::Value arg{Arg(index)};
-    if (!arg.IsImmediate()) {
-        UndoUse(arg);
-    }
-    if (!value.IsImmediate()) {
-        Use(value);
-    }
-    if (op == Opcode::Phi) {
-        phi_args[index].second = value;
-    } else {
-        args[index] = value;
-    }
+    ASSERT_MSG(index < NumArgs(), "Out of bounds argument index {} in opcode {}", index, op);
+    IR::Use& use{op == Opcode::Phi ? PhiData().operands[index].use : Slots()[index]};
+    RemoveUse(use);
+    use.value = value;
+    AddUse(use);
 }
 
 Block* Inst::PhiBlock(size_t index) const {
     if (op != Opcode::Phi) {
         throw LogicError("{} is not a Phi instruction", op);
     }
-    if (index >= phi_args.size()) {
-        throw InvalidArgument("Out of bounds argument index {} in phi instruction");
+    if (index >= num_phi_args) {
+        throw InvalidArgument("Out of bounds argument index {} in phi instruction", index);
     }
-    return phi_args[index].first;
+    return PhiData().operands[index].block;
 }
 
 void Inst::AddPhiOperand(Block* predecessor, const Value& value) {
-    if (!value.IsImmediate()) {
-        Use(value);
+    PhiStorage& phi{PhiData()};
+    if (num_phi_args == PhiCapacity(num_phi_args)) {
+        const u32 capacity{std::max<u32>(num_phi_args * 2, 2)};
+        PhiOperand* const operands{phi.pool->AllocatePhiOperands(capacity)};
+        if (phi.operands) {
+            for (u32 index = 0; index < num_phi_args; ++index) {
+                MoveUse(phi.operands[index].use, operands[index].use);
+                operands[index].block = phi.operands[index].block;
+            }
+            phi.pool->FreePhiOperands(phi.operands, num_phi_args);
+        }
+        phi.operands = operands;
     }
-    phi_args.emplace_back(predecessor, value);
+    PhiOperand& operand{phi.operands[num_phi_args++]};
+    operand = PhiOperand{.use{.value = value}, .block = predecessor};
+    AddUse(operand.use);
 }
 
 void Inst::Invalidate() {
@@ -114,32 +134,34 @@ void Inst::Invalidate() {
 
 void Inst::ClearArgs() {
     if (op == Opcode::Phi) {
-        for (auto& pair : phi_args) {
-            IR::Value& value{pair.second};
-            if (!value.IsImmediate()) {
-                UndoUse(value);
-            }
+        PhiOperand* const operands{PhiData().operands};
+        for (u32 index = 0; index < num_phi_args; ++index) {
+            RemoveUse(operands[index].use);
         }
-        phi_args.clear();
+        if (operands) {
+            PhiData().pool->FreePhiOperands(operands, PhiCapacity(num_phi_args));
+            PhiData().operands = nullptr;
+        }
+        num_phi_args = 0;
     } else {
-        for (auto& value : args) {
-            if (!value.IsImmediate()) {
-                UndoUse(value);
-            }
+        IR::Use* const slots{Slots()};
+        for (u32 index = 0; index < num_slots; ++index) {
+            RemoveUse(slots[index]);
+            slots[index].value = {};
         }
-        // Reset arguments to null
-        // std::memset was measured to be faster on MSVC than std::ranges:fill
-        std::memset(reinterpret_cast<char*>(&args), 0, sizeof(args));
     }
 }
 
 void Inst::ReplaceUsesWith(Value replacement) {
-    Invalidate();
-    ReplaceOpcode(Opcode::Identity);
-    if (!replacement.IsImmediate()) {
-        Use(replacement);
+    if (replacement == Value{this}) {
+        throw LogicError("Replacing {} with itself", op);
+    }
+    while (first_use) {
+        IR::Use& use{*first_use};
+        RemoveUse(use);
+        use.value = replacement;
+        AddUse(use);
     }
-    args[0] = replacement;
 }
 
 void Inst::ReplaceOpcode(IR::Opcode opcode) {
@@ -147,21 +169,47 @@ void Inst::ReplaceOpcode(IR::Opcode opcode) {
         throw LogicError("Cannot transition into Phi");
     }
     if (op == Opcode::Phi) {
-        // Transition out of phi arguments into non-phi
-        std::destroy_at(&phi_args);
-        std::construct_at(&args);
+        // Transition out of phi arguments into non-phi, the operand segment is not needed
+        // anymore and its slots become argument slots.
+        const PhiStorage phi{PhiData()};
+        if (phi.operands) {
+            phi.pool->FreePhiOperands(phi.operands, PhiCapacity(num_phi_args));
+        }
+        num_slots = NumPhiSlots;
+        InitSlots();
+    } else if (NumArgsOf(opcode) > num_slots) {
+        throw LogicError("{} does not have enough argument slots for {}", op, opcode);
     }
     op = opcode;
 }
 
-void Inst::Use(const Value& value) {
-    Inst* const inst{value.Inst()};
+void Inst::InitSlots() noexcept {
+    std::uninitialized_fill_n(Slots(), num_slots, IR::Use{});
+}
+
+void Inst::AddUse(IR::Use& use) noexcept {
+    if (use.value.IsImmediate()) {
+        return;
+    }
+    Inst* const inst{use.value.Inst()};
     ++inst->use_count;
+    use.prev = &inst->first_use;
+    use.next = inst->first_use;
+    if (use.next) {
+        use.next->prev = &use.next;
+    }
+    inst->first_use = &use;
 }
 
-void Inst::UndoUse(const Value& value) {
-    Inst* const inst{value.Inst()};
-    --inst->use_count;
+void Inst::RemoveUse(IR::Use& use) noexcept {
+    if (use.value.IsImmediate()) {
+        return;
+    }
+    --use.value.Inst()->use_count;
+    *use.prev = use.next;
+    if (use.next) {
+        use.next->prev = use.prev;
+    }
 }
 
 } // namespace Shader::IR
@@ -13,16 +13,20 @@
 //      https://link.springer.com/chapter/10.1007/978-3-642-37051-9_6
 //
 
+#include <array>
+#include <bit>
 #include <deque>
 #include <map>
 #include <span>
 #include <unordered_map>
 #include <variant>
 #include <vector>
+#include <boost/container/small_vector.hpp>
 
 #include "ir/basic_block.h"
 #include "ir/opcodes.h"
 #include "ir/reg.h"
+#include "ir/side_table.h"
 #include "ir/value.h"
 
 namespace Shader::Optimization {
@@ -46,64 +50,69 @@ struct GotoVariable : FlagTag {
 
 using Variant = std::variant<IR::ScalarReg, IR::VectorReg, ZeroFlagTag, SignFlagTag, CarryFlagTag,
                              OverflowFlagTag, GotoVariable>;
-using ValueMap = std::unordered_map<IR::Block*, IR::Value>;
+using ValueMap = IR::SideTable<IR::Block, IR::Value>;
 
 struct DefTable {
-    const IR::Value& Def(IR::Block* block, IR::ScalarReg variable) {
-        return block->ssa_sreg_values[RegIndex(variable)];
+    const IR::Value& Def(IR::Block* block, IR::ScalarReg variable) const {
+        return sregs[RegIndex(variable)].Get(block);
     }
     void SetDef(IR::Block* block, IR::ScalarReg variable, const IR::Value& value) {
-        block->ssa_sreg_values[RegIndex(variable)] = value;
+        sregs[RegIndex(variable)][block] = value;
     }
 
-    const IR::Value& Def(IR::Block* block, IR::VectorReg variable) {
-        return block->ssa_vreg_values[RegIndex(variable)];
+    const IR::Value& Def(IR::Block* block, IR::VectorReg variable) const {
+        return vregs[RegIndex(variable)].Get(block);
     }
     void SetDef(IR::Block* block, IR::VectorReg variable, const IR::Value& value) {
-        block->ssa_vreg_values[RegIndex(variable)] = value;
+        vregs[RegIndex(variable)][block] = value;
     }
 
-    const IR::Value& Def(IR::Block* block, GotoVariable variable) {
-        return goto_vars[variable.index][block];
+    const IR::Value& Def(IR::Block* block, GotoVariable variable) const {
+        const auto it{goto_vars.find(variable.index)};
+        return it != goto_vars.end() ? it->second.Get(block) : undefined;
     }
     void SetDef(IR::Block* block, GotoVariable variable, const IR::Value& value) {
-        goto_vars[variable.index].insert_or_assign(block, value);
+        goto_vars[variable.index][block] = value;
     }
 
-    const IR::Value& Def(IR::Block* block, ZeroFlagTag) {
-        return zero_flag[block];
+    const IR::Value& Def(IR::Block* block, ZeroFlagTag) const {
+        return zero_flag.Get(block);
     }
     void SetDef(IR::Block* block, ZeroFlagTag, const IR::Value& value) {
-        zero_flag.insert_or_assign(block, value);
+        zero_flag[block] = value;
     }
 
-    const IR::Value& Def(IR::Block* block, SignFlagTag) {
-        return sign_flag[block];
+    const IR::Value& Def(IR::Block* block, SignFlagTag) const {
+        return sign_flag.Get(block);
     }
     void SetDef(IR::Block* block, SignFlagTag, const IR::Value& value) {
-        sign_flag.insert_or_assign(block, value);
+        sign_flag[block] = value;
     }
 
-    const IR::Value& Def(IR::Block* block, CarryFlagTag) {
-        return carry_flag[block];
+    const IR::Value& Def(IR::Block* block, CarryFlagTag) const {
+        return carry_flag.Get(block);
     }
     void SetDef(IR::Block* block, CarryFlagTag, const IR::Value& value) {
-        carry_flag.insert_or_assign(block, value);
+        carry_flag[block] = value;
     }
 
-    const IR::Value& Def(IR::Block* block, OverflowFlagTag) {
-        return overflow_flag[block];
+    const IR::Value& Def(IR::Block* block, OverflowFlagTag) const {
+        return overflow_flag.Get(block);
     }
     void SetDef(IR::Block* block, OverflowFlagTag, const IR::Value& value) {
-        overflow_flag.insert_or_assign(block, value);
+        overflow_flag[block] = value;
     }
 
+    // Lookups don't grow the tables, so registers that are never defined keep an empty one.
+    std::array<ValueMap, IR::NumScalarRegs> sregs;
+    std::array<ValueMap, IR::NumVectorRegs> vregs;
     std::unordered_map<u32, ValueMap> goto_vars;
     ValueMap indirect_branch_var;
     ValueMap zero_flag;
     ValueMap sign_flag;
     ValueMap carry_flag;
     ValueMap overflow_flag;
+    IR::Value undefined;
 };
 
 IR::Opcode UndefOpcode(IR::ScalarReg) noexcept {
@@ -170,7 +179,7 @@ public:
             switch (stack.back().pc) {
             case Status::Start: {
                 if (const IR::Value& def = current_def.Def(block, variable); !def.IsEmpty()) {
-                    stack.back().result = def;
+                    stack.back().result = Forward(def);
                 } else if (!block->IsSsaSealed()) {
                     // Incomplete CFG
                     IR::Inst* phi{&*block->PrependNewInst(block->begin(), IR::Opcode::Phi)};
@@ -221,13 +230,10 @@ public:
     }
 
     void SealBlock(IR::Block* block) {
-        const auto it{incomplete_phis.find(block)};
-        if (it != incomplete_phis.end()) {
-            for (auto& pair : it->second) {
-                auto& variant{pair.first};
-                auto& phi{pair.second};
-                std::visit([&](auto& variable) { AddPhiOperands(variable, *phi, block); }, variant);
-            }
+        for (auto& pair : incomplete_phis[block]) {
+            auto& variant{pair.first};
+            auto& phi{pair.second};
+            std::visit([&](auto& variable) { AddPhiOperands(variable, *phi, block); }, variant);
         }
         block->SsaSeal();
     }
@@ -246,7 +252,7 @@ private:
         const size_t num_args{phi.NumArgs()};
         for (size_t arg_index = 0; arg_index < num_args; ++arg_index) {
             const IR::Value& op{phi.Arg(arg_index)};
-            if (op.Resolve() == same.Resolve() || op == IR::Value{&phi}) {
+            if (op == same || op == IR::Value{&phi}) {
                 // Unique value or self-reference
                 continue;
             }
@@ -256,45 +262,108 @@ private:
             }
             same = op;
         }
-        // Remove the phi node from the block, it will be reinserted
+        // Remove the phi node from the block
         IR::Block::InstructionList& list{block->Instructions()};
         list.erase(IR::Block::InstructionList::s_iterator_to(phi));
 
-        // Find the first non-phi instruction and use it as an insertion point
-        IR::Block::iterator reinsert_point{std::ranges::find_if_not(list, IR::IsPhi)};
         if (same.IsEmpty()) {
             // The phi is unreachable or in the start block
-            // Insert an undefined instruction and make it the phi node replacement
-            // The "phi" node reinsertion point is specified after this instruction
-            reinsert_point = block->PrependNewInst(reinsert_point, undef_opcode);
-            same = IR::Value{&*reinsert_point};
-            ++reinsert_point;
+            // Insert an undefined instruction before the first non-phi and make it the replacement
+            const IR::Block::iterator insert_point{std::ranges::find_if_not(list, IR::IsPhi)};
+            same = IR::Value{&*block->PrependNewInst(insert_point, undef_opcode)};
         }
-        // Reinsert the phi node and reroute all its uses to the "same" value
-        list.insert(reinsert_point, phi);
+        // Reroute all uses of the phi node to the "same" value
         phi.ReplaceUsesWith(same);
+        phi.Invalidate();
+        removed_phis[&phi] = same;
         // TODO: Try to recursively remove all phi users, which might have become trivial
         return same;
     }
 
-    std::unordered_map<IR::Block*, std::map<Variant, IR::Inst*>> incomplete_phis;
+    /// Definitions recorded before a phi was removed still point to it, follow them to the
+    /// value that replaced it.
+    IR::Value Forward(IR::Value value) const {
+        while (!value.IsImmediate() && !removed_phis.Get(value.Inst()).IsEmpty()) {
+            value = removed_phis.Get(value.Inst());
+        }
+        return value;
+    }
+
+    IR::SideTable<IR::Block, std::map<Variant, IR::Inst*>> incomplete_phis;
+    IR::SideTable<IR::Inst, IR::Value> removed_phis;
     DefTable current_def;
+
+public:
+    /// Registers hold untyped words, so their definitions are kept as U32 to give phis and
+    /// undefined values of a register a single type. F32 writes are bitcast to a word here.
+    IR::Value ToWord(IR::Block* block, IR::Inst& inst, const IR::Value& value) {
+        if (value.IsImmediate()) {
+            return IR::Value{std::bit_cast<u32>(value.F32())};
+        }
+        const IR::Block::iterator it{IR::Block::InstructionList::s_iterator_to(inst)};
+        IR::Inst* const cast{&*block->PrependNewInst(it, IR::Opcode::BitCastU32F32, {value})};
+        write_casts.emplace_back(block, cast);
+        return IR::Value{cast};
+    }
+
+    /// F32 reads of a register bitcast its word back. The word is often a phi that is only
+    /// resolved later, so casts are folded once the pass is done.
+    IR::Value FromWord(IR::Block* block, IR::Inst& inst, const IR::Value& word) {
+        if (word.IsImmediate()) {
+            return IR::Value{std::bit_cast<f32>(word.U32())};
+        }
+        const IR::Block::iterator it{IR::Block::InstructionList::s_iterator_to(inst)};
+        IR::Inst* const cast{&*block->PrependNewInst(it, IR::Opcode::BitCastF32U32, {word})};
+        read_casts.emplace_back(block, cast);
+        return IR::Value{cast};
+    }
+
+    /// Reads of a word written from an F32 value or an immediate use that value directly,
+    /// then the casts of F32 writes that are left without uses are removed.
+    void FoldCasts() {
+        for (const auto& [block, cast] : read_casts) {
+            const IR::Value word{cast->Arg(0)};
+            if (word.IsImmediate()) {
+                cast->ReplaceUsesWith(IR::Value{std::bit_cast<f32>(word.U32())});
+            } else if (word.Inst()->GetOpcode() == IR::Opcode::BitCastU32F32) {
+                cast->ReplaceUsesWith(word.Inst()->Arg(0));
+            } else {
+                continue;
+            }
+            Remove(block, cast);
+        }
+        for (const auto& [block, cast] : write_casts) {
+            if (!cast->HasUses()) {
+                Remove(block, cast);
+            }
+        }
+    }
+
+private:
+    static void Remove(IR::Block* block, IR::Inst* inst) {
+        inst->Invalidate();
+        block->Instructions().erase(IR::Block::InstructionList::s_iterator_to(*inst));
+    }
+
+    std::vector<std::pair<IR::Block*, IR::Inst*>> write_casts;
+    std::vector<std::pair<IR::Block*, IR::Inst*>> read_casts;
 };
 
-void VisitInst(Pass& pass, IR::Block* block, IR::Inst& inst) {
+/// Returns true if the instruction was replaced and can be removed.
+bool VisitInst(Pass& pass, IR::Block* block, IR::Inst& inst) {
     switch (inst.GetOpcode()) {
     case IR::Opcode::SetScalarRegisterU32:
-    case IR::Opcode::SetScalarRegisterF32: {
-        const IR::ScalarReg reg{inst.Arg(0).ScalarReg()};
-        pass.WriteVariable(reg, block, inst.Arg(1));
+        pass.WriteVariable(inst.Arg(0).ScalarReg(), block, inst.Arg(1));
+        break;
+    case IR::Opcode::SetScalarRegisterF32:
+        pass.WriteVariable(inst.Arg(0).ScalarReg(), block, pass.ToWord(block, inst, inst.Arg(1)));
         break;
-    }
     case IR::Opcode::SetVectorRegisterU32:
-    case IR::Opcode::SetVectorRegisterF32: {
-        const IR::VectorReg reg{inst.Arg(0).VectorReg()};
-        pass.WriteVariable(reg, block, inst.Arg(1));
+        pass.WriteVariable(inst.Arg(0).VectorReg(), block, inst.Arg(1));
+        break;
+    case IR::Opcode::SetVectorRegisterF32:
+        pass.WriteVariable(inst.Arg(0).VectorReg(), block, pass.ToWord(block, inst, inst.Arg(1)));
         break;
-    }
     case IR::Opcode::SetGotoVariable:
         pass.WriteVariable(GotoVariable{inst.Arg(0).U32()}, block, inst.Arg(1));
         break;
@@ -311,40 +380,51 @@ void VisitInst(Pass& pass, IR::Block* block, IR::Inst& inst) {
     //    pass.WriteVariable(OverflowFlagTag{}, block, inst.Arg(0));
     //    break;
     case IR::Opcode::GetScalarRegisterU32:
+        inst.ReplaceUsesWith(pass.ReadVariable(inst.Arg(0).ScalarReg(), block));
+        return true;
     case IR::Opcode::GetScalarRegisterF32: {
-        const IR::ScalarReg reg{inst.Arg(0).ScalarReg()};
-        inst.ReplaceUsesWith(pass.ReadVariable(reg, block));
-        break;
+        const IR::Value word{pass.ReadVariable(inst.Arg(0).ScalarReg(), block)};
+        inst.ReplaceUsesWith(pass.FromWord(block, inst, word));
+        return true;
     }
     case IR::Opcode::GetVectorRegisterU32:
+        inst.ReplaceUsesWith(pass.ReadVariable(inst.Arg(0).VectorReg(), block));
+        return true;
     case IR::Opcode::GetVectorRegisterF32: {
-        const IR::VectorReg reg{inst.Arg(0).VectorReg()};
-        inst.ReplaceUsesWith(pass.ReadVariable(reg, block));
-        break;
+        const IR::Value word{pass.ReadVariable(inst.Arg(0).VectorReg(), block)};
+        inst.ReplaceUsesWith(pass.FromWord(block, inst, word));
+        return true;
     }
     case IR::Opcode::GetGotoVariable:
         inst.ReplaceUsesWith(pass.ReadVariable(GotoVariable{inst.Arg(0).U32()}, block));
-        break;
+        return true;
     //case IR::Opcode::GetZFlag:
     //    inst.ReplaceUsesWith(pass.ReadVariable(ZeroFlagTag{}, block));
-    //    break;
+    //    return true;
     //case IR::Opcode::GetSFlag:
     //    inst.ReplaceUsesWith(pass.ReadVariable(SignFlagTag{}, block));
-    //    break;
+    //    return true;
     //case IR::Opcode::GetCFlag:
     //    inst.ReplaceUsesWith(pass.ReadVariable(CarryFlagTag{}, block));
-    //    break;
+    //    return true;
     //case IR::Opcode::GetOFlag:
     //    inst.ReplaceUsesWith(pass.ReadVariable(OverflowFlagTag{}, block));
-    //    break;
+    //    return true;
     default:
         break;
     }
+    return false;
 }
 
 void VisitBlock(Pass& pass, IR::Block* block) {
-    for (IR::Inst& inst : block->Instructions()) {
-        VisitInst(pass, block, inst);
+    // Reads only insert and remove phi nodes, which come before the visited instruction.
+    for (auto inst = block->begin(); inst != block->end();) {
+        if (VisitInst(pass, block, *inst)) {
+            inst->Invalidate();
+            inst = block->Instructions().erase(inst);
+        } else {
+            ++inst;
+        }
     }
     pass.SealBlock(block);
 }
@@ -357,31 +437,7 @@ void SsaRewritePass(IR::BlockList& program) {
     for (auto block = program.rbegin(); block != end; ++block) {
         VisitBlock(pass, *block);
     }
-}
-
-void IdentityRemovalPass(IR::BlockList& program) {
-    std::vector<IR::Inst*> to_invalidate;
-    for (IR::Block* const block : program) {
-        for (auto inst = block->begin(); inst != block->end();) {
-            const size_t num_args{inst->NumArgs()};
-            for (size_t i = 0; i < num_args; ++i) {
-                IR::Value arg;
-                while ((arg = inst->Arg(i)).IsIdentity()) {
-                    inst->SetArg(i, arg.Inst()->Arg(0));
-                }
-            }
-            if (inst->GetOpcode() == IR::Opcode::Identity ||
-                inst->GetOpcode() == IR::Opcode::Void) {
-                to_invalidate.push_back(&*inst);
-                inst = block->Instructions().erase(inst);
-            } else {
-                ++inst;
-            }
-        }
-    }
-    for (IR::Inst* const inst : to_invalidate) {
-        inst->Invalidate();
-    }
+    pass.FoldCasts();
 }
 
 void DeadCodeEliminationPass(IR::BlockList& program) {
@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include "exception.h"
+#include "ir/basic_block.h"
+#include "ir/program.h"
+#include "ir/side_table.h"
+#include "ir/type.h"
+#include "ir/value.h"
+
+namespace Shader::Optimization {
+
+namespace {
+
+void ValidateTypes(const IR::Program& program) {
+    for (const IR::Block* const block : program.blocks) {
+        for (const IR::Inst& inst : *block) {
+            const IR::Opcode op{inst.GetOpcode()};
+            const size_t num_args{inst.NumArgs()};
+            if (op == IR::Opcode::Phi) {
+                // Phi nodes store their type in their flags
+                const IR::Type type{inst.Flags<IR::Type>()};
+                for (size_t i = 0; i < num_args; ++i) {
+                    const IR::Type arg_type{inst.Arg(i).Type()};
+                    if (!IR::AreTypesCompatible(type, arg_type)) {
+                        throw LogicError("Phi operand {} is {} instead of {}", i, arg_type, type);
+                    }
+                }
+                continue;
+            }
+            for (size_t i = 0; i < num_args; ++i) {
+                const IR::Type t1{inst.Arg(i).Type()};
+                const IR::Type t2{IR::ArgTypeOf(op, i)};
+                if (!IR::AreTypesCompatible(t1, t2)) {
+                    throw LogicError("Invalid types in {}: {} and {} in argument {}", op, t1, t2,
+                                     i);
+                }
+            }
+        }
+    }
+}
+
+void ValidateUses(const IR::Program& program) {
+    IR::SideTable<IR::Inst, int> actual_uses;
+    for (const IR::Block* const block : program.blocks) {
+        for (const IR::Inst& inst : *block) {
+            const size_t num_args{inst.NumArgs()};
+            for (size_t i = 0; i < num_args; ++i) {
+                const IR::Value arg{inst.Arg(i)};
+                if (!arg.IsImmediate()) {
+                    ++actual_uses[arg.Inst()];
+                }
+            }
+        }
+    }
+    for (const IR::Block* const block : program.blocks) {
+        for (const IR::Inst& inst : *block) {
+            const int uses{actual_uses.Get(&inst)};
+            if (inst.UseCount() != uses) {
+                throw LogicError("Invalid uses in {}: counted {} but {} are recorded",
+                                 inst.GetOpcode(), uses, inst.UseCount());
+            }
+            int listed_uses{};
+            for (const IR::Use* use = inst.FirstUse(); use; use = use->next) {
+                if (use->value != IR::Value{const_cast<IR::Inst*>(&inst)}) {
+                    throw LogicError("Use list of {} holds another value", inst.GetOpcode());
+                }
+                ++listed_uses;
+            }
+            if (listed_uses != uses) {
+                throw LogicError("Invalid uses in {}: counted {} but {} are listed",
+                                 inst.GetOpcode(), uses, listed_uses);
+            }
+        }
+    }
+}
+
+void ValidateForwardDeclarations(const IR::Program& program) {
+    IR::IndexSet<IR::Inst> definitions;
+    for (const IR::Block* const block : program.blocks) {
+        for (const IR::Inst& inst : *block) {
+            definitions.Insert(&inst);
+            if (inst.GetOpcode() == IR::Opcode::Phi) {
+                // Phi nodes can have forward declarations
+                continue;
+            }
+            const size_t num_args{inst.NumArgs()};
+            for (size_t arg = 0; arg < num_args; ++arg) {
+                const IR::Value value{inst.Arg(arg)};
+                if (!value.IsImmediate() && !definitions.Contains(value.Inst())) {
+                    throw LogicError("Forward declaration in argument {} of {}", arg,
+                                     inst.GetOpcode());
+                }
+            }
+        }
+    }
+}
+
+void ValidatePhiBlocks(const IR::Program& program) {
+    for (const IR::Block* const block : program.blocks) {
+        const auto preds{block->ImmPredecessors()};
+        for (const IR::Inst& inst : *block) {
+            if (inst.GetOpcode() != IR::Opcode::Phi) {
+                continue;
+            }
+            const size_t num_args{inst.NumArgs()};
+            for (size_t i = 0; i < num_args; ++i) {
+                if (std::ranges::find(preds, inst.PhiBlock(i)) == preds.end()) {
+                    throw LogicError("Phi operand {} does not come from a predecessor", i);
+                }
+            }
+        }
+    }
+}
+
+} // Anonymous namespace
+
+void VerificationPass(const IR::Program& program) {
+    ValidateTypes(program);
+    ValidateUses(program);
+    ValidateForwardDeclarations(program);
+    ValidatePhiBlocks(program);
+}
+
+} // namespace Shader::Optimization
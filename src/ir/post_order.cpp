@@ -2,28 +2,28 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
-#include <boost/container/flat_set.hpp>
 #include <boost/container/small_vector.hpp>
 #include "ir/post_order.h"
+#include "ir/side_table.h"
 
 namespace Shader::IR {
 
 BlockList PostOrder(const AbstractSyntaxNode& root) {
     boost::container::small_vector<Block*, 16> block_stack;
-    boost::container::flat_set<Block*> visited;
+    IndexSet<Block> visited;
     BlockList post_order_blocks;
 
     if (root.type != AbstractSyntaxNode::Type::Block) {
         throw LogicError("First node in abstract syntax list root is not a block");
     }
     Block* const first_block{root.data.block};
-    visited.insert(first_block);
+    visited.Insert(first_block);
     block_stack.push_back(first_block);
 
     while (!block_stack.empty()) {
         Block* const block = block_stack.back();
         const auto visit = [&](Block* branch) {
-            if (!visited.insert(branch).second) {
+            if (!visited.Insert(branch)) {
                 return false;
             }
             // Calling push_back twice is faster than insert on MSVC
@@ -1,31 +1,172 @@
 // SPDX-FileCopyrightText: Copyright 2021 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
-#include <map>
+#include <algorithm>
+#include <optional>
 #include <string>
 
 #include <fmt/format.h>
 
+#include "exception.h"
 #include "ir/basic_block.h"
 #include "ir/program.h"
 #include "ir/value.h"
 
 namespace Shader::IR {
 
+namespace {
+
+/// Maps the blocks and instructions of a program to their copies.
+class CloneMap {
+public:
+    explicit CloneMap(InstPool& inst_pool_) : inst_pool{inst_pool_} {}
+
+    Block* Map(const Block* block) const {
+        Block* const clone{blocks.Get(block)};
+        if (!clone) {
+            throw LogicError("Block is not part of the cloned program");
+        }
+        return clone;
+    }
+
+    Value Map(const Value& value) const {
+        if (value.IsImmediate()) {
+            // Wide immediates are stored by the pool of their program
+            switch (value.Type()) {
+            case Type::U64:
+                return Value{value.U64(), inst_pool};
+            case Type::F64:
+                return Value{value.F64(), inst_pool};
+            default:
+                return value;
+            }
+        }
+        Inst* const clone{insts.Get(value.Inst())};
+        if (!clone) {
+            throw LogicError("{} is not part of the cloned program", value.Inst()->GetOpcode());
+        }
+        return Value{clone};
+    }
+
+    U1 Map(const U1& value) const {
+        return U1{Map(static_cast<const Value&>(value))};
+    }
+
+    void MapBlocks(std::span<Block* const> list, BlockList& result) const {
+        result.resize(list.size());
+        std::ranges::transform(list, result.begin(), [this](Block* block) { return Map(block); });
+    }
+
+    SideTable<Block, Block*> blocks{0, nullptr};
+    SideTable<Inst, Inst*> insts{0, nullptr};
+    InstPool& inst_pool;
+};
+
+} // Anonymous namespace
+
 std::string DumpProgram(const Program& program) {
     size_t index{0};
-    std::map<const IR::Inst*, size_t> inst_to_index;
-    std::map<const IR::Block*, size_t> block_to_index;
+    SideTable<IR::Inst, size_t> inst_to_index;
+    SideTable<IR::Block, std::optional<size_t>> block_to_index;
 
     for (const IR::Block* const block : program.blocks) {
-        block_to_index.emplace(block, index);
+        block_to_index[block] = index;
         ++index;
     }
+    // Instructions are numbered from one in program order, independently of the blocks.
+    size_t inst_index{0};
     std::string ret;
     for (const auto& block : program.blocks) {
-        ret += IR::DumpBlock(*block, block_to_index, inst_to_index, index) + '\n';
+        ret += IR::DumpBlock(*block, block_to_index, inst_to_index, inst_index) + '\n';
     }
     return ret;
 }
 
+Program CloneProgram(const Program& program, ObjectPool<Block>& block_pool,
+                     InstPool& inst_pool) {
+    // Create every block and instruction first, arguments may refer to later blocks.
+    CloneMap map{inst_pool};
+    for (const Block* const block : program.blocks) {
+        Block* const clone{block_pool.Create(inst_pool)};
+        clone->SetDefinition(block->Definition<u32>());
+        if (block->IsSsaSealed()) {
+            clone->SsaSeal();
+        }
+        for (const Inst& inst : *block) {
+            Inst* const inst_clone{inst_pool.Create(inst.GetOpcode(), inst.Flags<u32>())};
+            inst_clone->SetDefinition(inst.Definition<u32>());
+            clone->Instructions().push_back(*inst_clone);
+            map.insts[&inst] = inst_clone;
+        }
+        map.blocks[block] = clone;
+    }
+
+    // Then remap the branches and arguments to the copies.
+    BlockList preds;
+    BlockList succs;
+    for (const Block* const block : program.blocks) {
+        Block* const clone{map.Map(block)};
+        map.MapBlocks(block->ImmPredecessors(), preds);
+        map.MapBlocks(block->ImmSuccessors(), succs);
+        clone->SetBranches(preds, succs);
+
+        auto inst_clone{clone->begin()};
+        for (const Inst& inst : *block) {
+            const size_t num_args{inst.NumArgs()};
+            if (IsPhi(inst)) {
+                for (size_t index = 0; index < num_args; ++index) {
+                    inst_clone->AddPhiOperand(map.Map(inst.PhiBlock(index)),
+                                              map.Map(inst.Arg(index)));
+                }
+            } else {
+                for (size_t index = 0; index < num_args; ++index) {
+                    inst_clone->SetArg(index, map.Map(inst.Arg(index)));
+                }
+            }
+            ++inst_clone;
+        }
+    }
+
+    Program result;
+    map.MapBlocks(program.blocks, result.blocks);
+    map.MapBlocks(program.post_order_blocks, result.post_order_blocks);
+    result.syntax_list.reserve(program.syntax_list.size());
+    for (AbstractSyntaxNode node : program.syntax_list) {
+        auto& data{node.data};
+        switch (node.type) {
+        case AbstractSyntaxNode::Type::Block:
+            data.block = map.Map(data.block);
+            break;
+        case AbstractSyntaxNode::Type::If:
+            data.if_node.cond = map.Map(data.if_node.cond);
+            data.if_node.body = map.Map(data.if_node.body);
+            data.if_node.merge = map.Map(data.if_node.merge);
+            break;
+        case AbstractSyntaxNode::Type::EndIf:
+            data.end_if.merge = map.Map(data.end_if.merge);
+            break;
+        case AbstractSyntaxNode::Type::Loop:
+            data.loop.body = map.Map(data.loop.body);
+            data.loop.continue_block = map.Map(data.loop.continue_block);
+            data.loop.merge = map.Map(data.loop.merge);
+            break;
+        case AbstractSyntaxNode::Type::Repeat:
+            data.repeat.cond = map.Map(data.repeat.cond);
+            data.repeat.loop_header = map.Map(data.repeat.loop_header);
+            data.repeat.merge = map.Map(data.repeat.merge);
+            break;
+        case AbstractSyntaxNode::Type::Break:
+            data.break_node.cond = map.Map(data.break_node.cond);
+            data.break_node.merge = map.Map(data.break_node.merge);
+            data.break_node.skip = map.Map(data.break_node.skip);
+            break;
+        case AbstractSyntaxNode::Type::Return:
+        case AbstractSyntaxNode::Type::Unreachable:
+            break;
+        }
+        result.syntax_list.push_back(node);
+    }
+    return result;
+}
+
 } // namespace Shader::IR
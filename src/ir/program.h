@@ -18,4 +18,9 @@ struct Program {
 
 [[nodiscard]] std::string DumpProgram(const Program& program);
 
+/// Copies the syntax list, blocks and instructions of a program into the given pools, so
+/// variants can be derived from one translation. The copy shares nothing with the original.
+[[nodiscard]] Program CloneProgram(const Program& program, ObjectPool<Block>& block_pool,
+                                   InstPool& inst_pool);
+
 } // namespace Shader::IR
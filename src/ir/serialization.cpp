@@ -0,0 +1,471 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+#include "exception.h"
+#include "ir/serialization.h"
+
+namespace Shader::IR {
+
+namespace {
+
+constexpr u32 Magic = 0x52495253; // "SRIR"
+constexpr u32 InvalidIndex = std::numeric_limits<u32>::max();
+constexpr size_t SectionAlignment = 8;
+
+struct Section {
+    u32 offset;
+    u32 count;
+};
+
+struct Header {
+    u32 magic;
+    u32 version;
+    u32 size;
+    u32 reserved;
+    Section blocks;
+    Section edges;      ///< Block numbers, predecessors then successors of every block.
+    Section insts;
+    Section args;
+    Section phi_blocks; ///< Block numbers of the phi operands.
+    Section syntax_nodes;
+    Section post_order; ///< Block numbers.
+};
+
+struct BlockRecord {
+    u32 first_inst;
+    u32 num_insts;
+    u32 first_edge;
+    u32 num_preds;
+    u32 num_succs;
+    u32 definition;
+    u32 is_ssa_sealed;
+    u32 reserved;
+};
+
+struct InstRecord {
+    u32 opcode;
+    u32 flags;
+    u32 definition;
+    u32 first_arg;
+    u32 num_args;
+    u32 first_phi_block;
+};
+
+/// Arguments refer to instructions by their number, other values keep their immediate type.
+struct ArgRecord {
+    static constexpr u32 InstType = std::numeric_limits<u32>::max();
+
+    u32 type;
+    u32 reserved;
+    u64 payload;
+};
+
+struct SyntaxRecord {
+    u32 type;
+    std::array<u32, 3> blocks;
+    ArgRecord cond;
+};
+
+/// Fields of a syntax node that refer to the program, which depend on the node type.
+struct SyntaxFields {
+    std::array<Block**, 3> blocks{};
+    U1* cond{};
+};
+
+SyntaxFields FieldsOf(AbstractSyntaxNode& node) {
+    auto& data{node.data};
+    switch (node.type) {
+    case AbstractSyntaxNode::Type::Block:
+        return {.blocks{&data.block}};
+    case AbstractSyntaxNode::Type::If:
+        return {.blocks{&data.if_node.body, &data.if_node.merge}, .cond = &data.if_node.cond};
+    case AbstractSyntaxNode::Type::EndIf:
+        return {.blocks{&data.end_if.merge}};
+    case AbstractSyntaxNode::Type::Loop:
+        return {.blocks{&data.loop.body, &data.loop.continue_block, &data.loop.merge}};
+    case AbstractSyntaxNode::Type::Repeat:
+        return {.blocks{&data.repeat.loop_header, &data.repeat.merge}, .cond = &data.repeat.cond};
+    case AbstractSyntaxNode::Type::Break:
+        return {.blocks{&data.break_node.merge, &data.break_node.skip},
+                .cond = &data.break_node.cond};
+    case AbstractSyntaxNode::Type::Return:
+    case AbstractSyntaxNode::Type::Unreachable:
+        return {};
+    }
+    throw InvalidArgument("Invalid syntax node type {}", static_cast<u32>(node.type));
+}
+
+class Writer {
+public:
+    explicit Writer(const Program& program) {
+        for (u32 index = 0; index < program.blocks.size(); ++index) {
+            block_numbers[program.blocks[index]] = index;
+        }
+        u32 num_insts{};
+        for (const Block* const block : program.blocks) {
+            for (const Inst& inst : *block) {
+                inst_numbers[&inst] = num_insts++;
+            }
+        }
+    }
+
+    u32 Number(const Block* block) const {
+        const u32 number{block_numbers.Get(block)};
+        if (number == InvalidIndex) {
+            throw LogicError("Block is not part of the serialized program");
+        }
+        return number;
+    }
+
+    ArgRecord Encode(const Value& value) const {
+        if (value.IsEmpty()) {
+            return {.type = static_cast<u32>(Type::Void), .reserved = 0, .payload = 0};
+        }
+        if (!value.IsImmediate()) {
+            const u32 number{inst_numbers.Get(value.Inst())};
+            if (number == InvalidIndex) {
+                throw LogicError("{} is not part of the serialized program",
+                                 value.Inst()->GetOpcode());
+            }
+            return {.type = ArgRecord::InstType, .reserved = 0, .payload = number};
+        }
+        const Type type{value.Type()};
+        const auto record{[type](u64 payload) {
+            return ArgRecord{.type = static_cast<u32>(type), .reserved = 0, .payload = payload};
+        }};
+        switch (type) {
+        case Type::ScalarReg:
+            return record(static_cast<u64>(value.ScalarReg()));
+        case Type::VectorReg:
+            return record(static_cast<u64>(value.VectorReg()));
+        case Type::Attribute:
+            return record(static_cast<u64>(value.Attribute()));
+        case Type::U1:
+            return record(value.U1() ? 1 : 0);
+        case Type::U8:
+            return record(value.U8());
+        case Type::U16:
+            return record(value.U16());
+        case Type::U32:
+            return record(value.U32());
+        case Type::U64:
+            return record(value.U64());
+        case Type::F32:
+            return record(std::bit_cast<u32>(value.F32()));
+        case Type::F64:
+            return record(std::bit_cast<u64>(value.F64()));
+        default:
+            throw NotImplementedException("Serializing {} immediate", type);
+        }
+    }
+
+private:
+    SideTable<Block, u32> block_numbers{0, InvalidIndex};
+    SideTable<Inst, u32> inst_numbers{0, InvalidIndex};
+};
+
+template <typename T>
+void AppendSection(std::vector<u8>& image, Section& section, const std::vector<T>& records) {
+    static_assert(std::is_trivially_copyable_v<T> && alignof(T) <= SectionAlignment);
+    const size_t offset{(image.size() + SectionAlignment - 1) & ~(SectionAlignment - 1)};
+    const size_t size{records.size() * sizeof(T)};
+    if (offset + size > std::numeric_limits<u32>::max()) {
+        throw LogicError("Program is too large to serialize");
+    }
+    image.resize(offset + size);
+    if (size != 0) {
+        std::memcpy(image.data() + offset, records.data(), size);
+    }
+    section = {.offset = static_cast<u32>(offset), .count = static_cast<u32>(records.size())};
+}
+
+template <typename T>
+std::span<const T> ReadSection(std::span<const u8> image, const Section& section) {
+    if (section.offset % SectionAlignment != 0 || section.offset > image.size() ||
+        (image.size() - section.offset) / sizeof(T) < section.count) {
+        throw InvalidArgument("Section at {:#x} is out of bounds", section.offset);
+    }
+    return {reinterpret_cast<const T*>(image.data() + section.offset), section.count};
+}
+
+/// Checks that the range [first, first + count) is within a section of size records.
+void CheckRange(u32 first, u32 count, size_t size, const char* what) {
+    if (first > size || count > size - first) {
+        throw InvalidArgument("{} range out of bounds", what);
+    }
+}
+
+template <typename T>
+T* Lookup(std::span<T* const> objects, u32 number, const char* what) {
+    if (number >= objects.size()) {
+        throw InvalidArgument("{} {} out of bounds", what, number);
+    }
+    return objects[number];
+}
+
+/// Checks that a register or attribute number is below count.
+u64 CheckNumber(u64 number, size_t count, const char* what) {
+    if (number >= count) {
+        throw InvalidArgument("{} {} out of bounds", what, number);
+    }
+    return number;
+}
+
+Value Decode(const ArgRecord& arg, std::span<Inst* const> insts, InstPool& inst_pool) {
+    if (arg.type == ArgRecord::InstType) {
+        return Value{Lookup(insts, static_cast<u32>(arg.payload), "Instruction")};
+    }
+    const Type type{static_cast<Type>(arg.type)};
+    switch (type) {
+    case Type::Void:
+        return Value{};
+    case Type::ScalarReg:
+        return Value{static_cast<ScalarReg>(
+            CheckNumber(arg.payload, NumScalarRegs, "Scalar register"))};
+    case Type::VectorReg:
+        return Value{static_cast<VectorReg>(
+            CheckNumber(arg.payload, NumVectorRegs, "Vector register"))};
+    case Type::Attribute:
+        return Value{static_cast<Attribute>(CheckNumber(arg.payload, NumAttributes, "Attribute"))};
+    case Type::U1:
+        return Value{arg.payload != 0};
+    case Type::U8:
+        return Value{static_cast<u8>(arg.payload)};
+    case Type::U16:
+        return Value{static_cast<u16>(arg.payload)};
+    case Type::U32:
+        return Value{static_cast<u32>(arg.payload)};
+    case Type::U64:
+        return Value{arg.payload, inst_pool};
+    case Type::F32:
+        return Value{std::bit_cast<f32>(static_cast<u32>(arg.payload))};
+    case Type::F64:
+        return Value{std::bit_cast<f64>(arg.payload), inst_pool};
+    default:
+        throw InvalidArgument("Invalid argument type {:#x}", arg.type);
+    }
+}
+
+/// Decodes an argument whose type has to be compatible with expected. Checked in every build,
+/// unlike TypedValue, as the image comes from outside.
+Value DecodeTyped(const ArgRecord& arg, Type expected, std::span<Inst* const> insts,
+                  InstPool& inst_pool, const char* what) {
+    const Value value{Decode(arg, insts, inst_pool)};
+    if (!AreTypesCompatible(value.Type(), expected)) {
+        throw InvalidArgument("{} is {} instead of {}", what, value.Type(), expected);
+    }
+    return value;
+}
+
+} // Anonymous namespace
+
+std::vector<u8> SerializeProgram(const Program& program) {
+    const Writer writer{program};
+    std::vector<BlockRecord> blocks;
+    std::vector<u32> edges;
+    std::vector<InstRecord> insts;
+    std::vector<ArgRecord> args;
+    std::vector<u32> phi_blocks;
+    blocks.reserve(program.blocks.size());
+    for (const Block* const block : program.blocks) {
+        blocks.push_back(BlockRecord{
+            .first_inst = static_cast<u32>(insts.size()),
+            .num_insts = static_cast<u32>(block->size()),
+            .first_edge = static_cast<u32>(edges.size()),
+            .num_preds = static_cast<u32>(block->ImmPredecessors().size()),
+            .num_succs = static_cast<u32>(block->ImmSuccessors().size()),
+            .definition = block->Definition<u32>(),
+            .is_ssa_sealed = block->IsSsaSealed() ? 1U : 0U,
+            .reserved = 0,
+        });
+        for (const Block* const pred : block->ImmPredecessors()) {
+            edges.push_back(writer.Number(pred));
+        }
+        for (const Block* const succ : block->ImmSuccessors()) {
+            edges.push_back(writer.Number(succ));
+        }
+        for (const Inst& inst : *block) {
+            const u32 num_args{static_cast<u32>(inst.NumArgs())};
+            insts.push_back(InstRecord{
+                .opcode = static_cast<u32>(inst.GetOpcode()),
+                .flags = inst.Flags<u32>(),
+                .definition = inst.Definition<u32>(),
+                .first_arg = static_cast<u32>(args.size()),
+                .num_args = num_args,
+                .first_phi_block = static_cast<u32>(phi_blocks.size()),
+            });
+            for (u32 index = 0; index < num_args; ++index) {
+                args.push_back(writer.Encode(inst.Arg(index)));
+                if (IsPhi(inst)) {
+                    phi_blocks.push_back(writer.Number(inst.PhiBlock(index)));
+                }
+            }
+        }
+    }
+
+    std::vector<SyntaxRecord> syntax_nodes;
+    syntax_nodes.reserve(program.syntax_list.size());
+    for (AbstractSyntaxNode node : program.syntax_list) {
+        const SyntaxFields fields{FieldsOf(node)};
+        SyntaxRecord& record{syntax_nodes.emplace_back()};
+        record.type = static_cast<u32>(node.type);
+        for (size_t index = 0; index < fields.blocks.size(); ++index) {
+            record.blocks[index] =
+                fields.blocks[index] ? writer.Number(*fields.blocks[index]) : InvalidIndex;
+        }
+        record.cond = fields.cond ? writer.Encode(*fields.cond) : ArgRecord{};
+    }
+
+    std::vector<u32> post_order;
+    post_order.reserve(program.post_order_blocks.size());
+    for (const Block* const block : program.post_order_blocks) {
+        post_order.push_back(writer.Number(block));
+    }
+
+    Header header{};
+    header.magic = Magic;
+    header.version = ProgramBinaryVersion;
+    std::vector<u8> image(sizeof(Header));
+    AppendSection(image, header.blocks, blocks);
+    AppendSection(image, header.edges, edges);
+    AppendSection(image, header.insts, insts);
+    AppendSection(image, header.args, args);
+    AppendSection(image, header.phi_blocks, phi_blocks);
+    AppendSection(image, header.syntax_nodes, syntax_nodes);
+    AppendSection(image, header.post_order, post_order);
+    header.size = static_cast<u32>(image.size());
+    std::memcpy(image.data(), &header, sizeof(header));
+    return image;
+}
+
+Program DeserializeProgram(std::span<const u8> image, ObjectPool<Block>& block_pool,
+                           InstPool& inst_pool) {
+    Header header;
+    if (image.size() < sizeof(header)) {
+        throw InvalidArgument("Program image is too small");
+    }
+    if (reinterpret_cast<uintptr_t>(image.data()) % SectionAlignment != 0) {
+        throw InvalidArgument("Program image is not aligned");
+    }
+    std::memcpy(&header, image.data(), sizeof(header));
+    if (header.magic != Magic) {
+        throw InvalidArgument("Invalid program image magic {:#x}", header.magic);
+    }
+    if (header.version != ProgramBinaryVersion) {
+        throw InvalidArgument("Program image version {} does not match {}", header.version,
+                              ProgramBinaryVersion);
+    }
+    if (header.size != image.size()) {
+        throw InvalidArgument("Program image size {} does not match {}", header.size,
+                              image.size());
+    }
+    const auto block_records{ReadSection<BlockRecord>(image, header.blocks)};
+    const auto edges{ReadSection<u32>(image, header.edges)};
+    const auto inst_records{ReadSection<InstRecord>(image, header.insts)};
+    const auto args{ReadSection<ArgRecord>(image, header.args)};
+    const auto phi_blocks{ReadSection<u32>(image, header.phi_blocks)};
+    const auto syntax_nodes{ReadSection<SyntaxRecord>(image, header.syntax_nodes)};
+    const auto post_order{ReadSection<u32>(image, header.post_order)};
+
+    // Create every block and instruction first, arguments may refer to later ones.
+    Program program;
+    std::vector<Inst*> insts;
+    program.blocks.reserve(block_records.size());
+    insts.reserve(inst_records.size());
+    for (const BlockRecord& record : block_records) {
+        if (record.first_inst != insts.size()) {
+            throw InvalidArgument("Block instructions are not contiguous");
+        }
+        CheckRange(record.first_inst, record.num_insts, inst_records.size(), "Instruction");
+        Block* const block{block_pool.Create(inst_pool)};
+        block->SetDefinition(record.definition);
+        if (record.is_ssa_sealed != 0) {
+            block->SsaSeal();
+        }
+        for (const InstRecord& inst_record : inst_records.subspan(record.first_inst,
+                                                                  record.num_insts)) {
+            if (inst_record.opcode >= std::size(Detail::META_TABLE)) {
+                throw InvalidArgument("Invalid opcode {}", inst_record.opcode);
+            }
+            const Opcode op{static_cast<Opcode>(inst_record.opcode)};
+            Inst* const inst{inst_pool.Create(op, inst_record.flags)};
+            inst->SetDefinition(inst_record.definition);
+            block->Instructions().push_back(*inst);
+            insts.push_back(inst);
+        }
+        program.blocks.push_back(block);
+    }
+    if (insts.size() != inst_records.size()) {
+        throw InvalidArgument("Instructions outside of blocks");
+    }
+
+    // Then link the branches and arguments.
+    BlockList preds;
+    BlockList succs;
+    const auto map_blocks{[&](std::span<const u32> numbers, BlockList& result) {
+        result.clear();
+        for (const u32 number : numbers) {
+            result.push_back(Lookup<Block>(program.blocks, number, "Block"));
+        }
+    }};
+    for (size_t index = 0; index < block_records.size(); ++index) {
+        const BlockRecord& record{block_records[index]};
+        CheckRange(record.first_edge, record.num_preds, edges.size(), "Predecessor");
+        CheckRange(record.first_edge + record.num_preds, record.num_succs, edges.size(),
+                   "Successor");
+        map_blocks(edges.subspan(record.first_edge, record.num_preds), preds);
+        map_blocks(edges.subspan(record.first_edge + record.num_preds, record.num_succs), succs);
+        program.blocks[index]->SetBranches(preds, succs);
+    }
+    for (size_t index = 0; index < inst_records.size(); ++index) {
+        const InstRecord& record{inst_records[index]};
+        Inst* const inst{insts[index]};
+        CheckRange(record.first_arg, record.num_args, args.size(), "Argument");
+        if (IsPhi(*inst)) {
+            CheckRange(record.first_phi_block, record.num_args, phi_blocks.size(), "Phi block");
+            const Type type{inst->Flags<Type>()};
+            for (u32 arg = 0; arg < record.num_args; ++arg) {
+                Block* const block{Lookup<Block>(
+                    program.blocks, phi_blocks[record.first_phi_block + arg], "Block")};
+                inst->AddPhiOperand(block, DecodeTyped(args[record.first_arg + arg], type, insts,
+                                                       inst_pool, "Phi operand"));
+            }
+            continue;
+        }
+        const Opcode op{inst->GetOpcode()};
+        if (record.num_args != inst->NumArgs()) {
+            throw InvalidArgument("{} has {} arguments", op, record.num_args);
+        }
+        for (u32 arg = 0; arg < record.num_args; ++arg) {
+            inst->SetArg(arg, DecodeTyped(args[record.first_arg + arg], ArgTypeOf(op, arg), insts,
+                                          inst_pool, "Argument"));
+        }
+    }
+
+    program.syntax_list.reserve(syntax_nodes.size());
+    for (const SyntaxRecord& record : syntax_nodes) {
+        AbstractSyntaxNode& node{program.syntax_list.emplace_back()};
+        node.type = static_cast<AbstractSyntaxNode::Type>(record.type);
+        const SyntaxFields fields{FieldsOf(node)};
+        for (size_t index = 0; index < fields.blocks.size(); ++index) {
+            if (Block** const block{fields.blocks[index]}) {
+                *block = Lookup<Block>(program.blocks, record.blocks[index], "Block");
+            }
+        }
+        if (fields.cond && record.cond.type != static_cast<u32>(Type::Void)) {
+            *fields.cond = U1{DecodeTyped(record.cond, Type::U1, insts, inst_pool, "Condition")};
+        }
+    }
+    map_blocks(post_order, program.post_order_blocks);
+    return program;
+}
+
+} // namespace Shader::IR
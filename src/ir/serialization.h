@@ -0,0 +1,29 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "common/types.h"
+#include "ir/program.h"
+
+namespace Shader::IR {
+
+/// Version of the binary program format. Opcodes are stored by their number, so it must be
+/// bumped whenever opcodes.inc or the layout of the image changes.
+constexpr u32 ProgramBinaryVersion = 1;
+
+/// Writes a program into a self contained binary image. The image is a header followed by
+/// fixed size records in sections aligned to eight bytes, with blocks and instructions
+/// referred to by their position in it, so it can be memory mapped and read in place.
+/// Images use the byte order of the host that wrote them.
+[[nodiscard]] std::vector<u8> SerializeProgram(const Program& program);
+
+/// Rebuilds a program from an image written by SerializeProgram into the given pools.
+/// Throws InvalidArgument if the image is malformed or was written by another version.
+[[nodiscard]] Program DeserializeProgram(std::span<const u8> image,
+                                         ObjectPool<Block>& block_pool, InstPool& inst_pool);
+
+} // namespace Shader::IR
@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <vector>
+
+#include "common/types.h"
+
+namespace Shader::IR {
+
+/// Objects with a dense index, like blocks and instructions numbered by their pool.
+template <typename T>
+concept Indexed = requires(const T& object) {
+    { object.Index() } -> std::convertible_to<u32>;
+};
+
+/// Per object data of an analysis, stored in a vector indexed by the object index instead of
+/// a hashed or tree map. The table grows on demand, entries not written yet hold the default.
+template <Indexed Key, typename T>
+class SideTable {
+public:
+    SideTable() = default;
+    explicit SideTable(size_t size, const T& default_value_ = {})
+        : values(size, default_value_), default_value{default_value_} {}
+
+    [[nodiscard]] T& operator[](const Key* key) {
+        const u32 index{key->Index()};
+        if (index >= values.size()) {
+            values.resize(index + 1, default_value);
+        }
+        return values[index];
+    }
+
+    /// Returns the entry of key without growing the table.
+    [[nodiscard]] const T& Get(const Key* key) const noexcept {
+        const u32 index{key->Index()};
+        return index < values.size() ? values[index] : default_value;
+    }
+
+    void Clear() noexcept {
+        values.clear();
+    }
+
+private:
+    std::vector<T> values;
+    T default_value{};
+};
+
+/// Set of objects stored as a bitset over their indices.
+template <Indexed Key>
+class IndexSet {
+public:
+    IndexSet() = default;
+    explicit IndexSet(size_t size) : words((size + 63) / 64) {}
+
+    [[nodiscard]] bool Contains(const Key* key) const noexcept {
+        const u32 index{key->Index()};
+        return index / 64 < words.size() && (words[index / 64] >> (index % 64)) & 1;
+    }
+
+    /// Adds key to the set and returns true if it was not in it yet.
+    bool Insert(const Key* key) {
+        const u32 index{key->Index()};
+        if (index / 64 >= words.size()) {
+            words.resize(index / 64 + 1);
+        }
+        const u64 mask{u64{1} << (index % 64)};
+        const bool inserted{(words[index / 64] & mask) == 0};
+        words[index / 64] |= mask;
+        return inserted;
+    }
+
+    void Erase(const Key* key) noexcept {
+        const u32 index{key->Index()};
+        if (index / 64 < words.size()) {
+            words[index / 64] &= ~(u64{1} << (index % 64));
+        }
+    }
+
+    [[nodiscard]] size_t Count() const noexcept {
+        size_t count{};
+        for (const u64 word : words) {
+            count += std::popcount(word);
+        }
+        return count;
+    }
+
+    void Clear() noexcept {
+        std::ranges::fill(words, 0);
+    }
+
+private:
+    std::vector<u64> words;
+};
+
+} // namespace Shader::IR
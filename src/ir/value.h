@@ -3,13 +3,13 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <bit>
 #include <cstring>
 #include <memory>
 #include <type_traits>
 #include <utility>
-#include <boost/container/small_vector.hpp>
 #include <boost/intrusive/list.hpp>
 
 #include "common/assert.h"
@@ -23,9 +23,23 @@ namespace Shader::IR {
 
 class Block;
 class Inst;
+class InstPool;
 
 struct AssociatedInsts;
 
+/// Checks the types of instruction arguments as they are built. On in debug builds and with
+/// SHADER_VERIFY_IR, otherwise the static checks of TypedValue cover them without slowing down
+/// translation. Argument counts and indices are always checked.
+#if defined(SHADER_VERIFY_IR) || defined(_DEBUG)
+constexpr bool VerifyIR = true;
+#else
+constexpr bool VerifyIR = false;
+#endif
+
+/// A value is a single word. Instructions are stored as their pointer, which is aligned and
+/// leaves the low bit clear. Immediates set the low bit, keep their type in the low byte and
+/// their payload in the upper 56 bits. 64-bit immediates that don't fit are stored out of line
+/// by the InstPool of their program and keep the address of their bits instead.
 class Value {
 public:
     Value() noexcept = default;
@@ -38,19 +52,15 @@ public:
     explicit Value(u16 value) noexcept;
     explicit Value(u32 value) noexcept;
     explicit Value(f32 value) noexcept;
-    explicit Value(u64 value) noexcept;
-    explicit Value(f64 value) noexcept;
+    explicit Value(u64 value, InstPool& pool);
+    explicit Value(f64 value, InstPool& pool);
 
-    [[nodiscard]] bool IsIdentity() const noexcept;
     [[nodiscard]] bool IsPhi() const noexcept;
     [[nodiscard]] bool IsEmpty() const noexcept;
     [[nodiscard]] bool IsImmediate() const noexcept;
     [[nodiscard]] IR::Type Type() const noexcept;
 
     [[nodiscard]] IR::Inst* Inst() const;
-    [[nodiscard]] IR::Inst* InstRecursive() const;
-    [[nodiscard]] IR::Inst* TryInstRecursive() const;
-    [[nodiscard]] IR::Value Resolve() const;
     [[nodiscard]] IR::ScalarReg ScalarReg() const;
     [[nodiscard]] IR::VectorReg VectorReg() const;
     [[nodiscard]] IR::Attribute Attribute() const;
@@ -62,26 +72,54 @@ public:
     [[nodiscard]] u64 U64() const;
     [[nodiscard]] f64 F64() const;
 
-    [[nodiscard]] bool operator==(const Value& other) const;
-    [[nodiscard]] bool operator!=(const Value& other) const;
+    [[nodiscard]] bool operator==(const Value& other) const noexcept {
+        // Out of line immediates are unique within their pool, so equal values of a program
+        // always have equal words.
+        return raw == other.raw;
+    }
+    [[nodiscard]] bool operator!=(const Value& other) const noexcept {
+        return raw != other.raw;
+    }
 
 private:
-    IR::Type type{};
-    union {
-        IR::Inst* inst{};
-        IR::ScalarReg sreg;
-        IR::VectorReg vreg;
-        IR::Attribute attribute;
-        bool imm_u1;
-        u8 imm_u8;
-        u16 imm_u16;
-        u32 imm_u32;
-        f32 imm_f32;
-        u64 imm_u64;
-        f64 imm_f64;
-    };
+    static constexpr u64 ImmediateBit = 1;
+    static constexpr u64 TypeMask = 0x3F;  ///< Immediate bit and index of the type flag.
+    static constexpr u64 InternedBit = 0x80;
+    static constexpr u32 InternedShift = 3; ///< Out of line bits are aligned to eight bytes.
+    static constexpr u32 PayloadShift = 8;
+    static constexpr u64 MaxInlinePayload = (u64{1} << (64 - PayloadShift)) - 1;
+
+    [[nodiscard]] static constexpr u64 TagOf(IR::Type type) noexcept {
+        return static_cast<u64>(std::countr_zero(static_cast<u32>(type))) << 1 | ImmediateBit;
+    }
+
+    [[nodiscard]] static constexpr u64 MakeImmediate(IR::Type type, u64 payload) noexcept {
+        return payload << PayloadShift | TagOf(type);
+    }
+
+    [[nodiscard]] static u64 MakeImmediate64(IR::Type type, u64 bits, InstPool& pool);
+
+    [[nodiscard]] bool IsInst() const noexcept {
+        return raw != 0 && (raw & ImmediateBit) == 0;
+    }
+
+    [[nodiscard]] bool HasImmediateType(IR::Type type) const noexcept {
+        return (raw & TypeMask) == TagOf(type);
+    }
+
+    [[nodiscard]] IR::Inst* InstPointer() const noexcept {
+        return reinterpret_cast<IR::Inst*>(raw);
+    }
+
+    [[nodiscard]] u64 Payload() const noexcept {
+        return raw >> PayloadShift;
+    }
+
+    [[nodiscard]] u64 Payload64() const noexcept;
+
+    u64 raw{};
 };
-static_assert(static_cast<u32>(IR::Type::Void) == 0, "memset relies on IR::Type being zero");
+static_assert(sizeof(Value) == sizeof(u64), "Value size unintentionally increased");
 static_assert(std::is_trivially_copyable_v<Value>);
 
 template <IR::Type type_>
@@ -94,20 +132,36 @@ public:
     explicit(false) TypedValue(const TypedValue<other_type>& value) : Value(value) {}
 
     explicit TypedValue(const Value& value) : Value(value) {
-        if ((value.Type() & type_) == IR::Type::Void) {
-            throw InvalidArgument("Incompatible types {} and {}", type_, value.Type());
+        if constexpr (VerifyIR) {
+            if ((value.Type() & type_) == IR::Type::Void) {
+                throw InvalidArgument("Incompatible types {} and {}", type_, value.Type());
+            }
         }
     }
 
     explicit TypedValue(IR::Inst* inst_) : TypedValue(Value(inst_)) {}
 };
 
+/// Argument slot of an instruction. Slots holding an instruction are linked into its use list,
+/// so replacing an instruction rewrites its users directly.
+struct Use {
+    Value value;
+    Use* next{};
+    Use** prev{}; ///< Link that points to this use, either the previous use or the list head.
+};
+static_assert(sizeof(Use) == 3 * sizeof(u64), "Use size unintentionally increased");
+
+/// Incoming value of a phi node and the predecessor it comes from.
+struct PhiOperand {
+    Use use;
+    Block* block;
+};
+
+/// Instructions are created by an InstPool, with their argument slots stored right after them.
+/// Phi nodes store their operands in a separate segment of the pool that grows on demand.
 class Inst : public boost::intrusive::list_base_hook<> {
 public:
-    explicit Inst(IR::Opcode op_, u32 flags_) noexcept;
-    explicit Inst(const Inst& base);
-    ~Inst();
-
+    Inst(const Inst&) = delete;
     Inst& operator=(const Inst&) = delete;
 
     Inst& operator=(Inst&&) = delete;
@@ -123,6 +177,20 @@ public:
         return use_count > 0;
     }
 
+    /// Returns the first argument slot that uses this instruction, the rest follow through next.
+    [[nodiscard]] const Use* FirstUse() const noexcept {
+        return first_use;
+    }
+
+    /// Dense index of this instruction, given by the pool that created it. Stable for the
+    /// lifetime of the instruction and usable as a key of SideTable and IndexSet.
+    [[nodiscard]] u32 Index() const noexcept {
+        return index;
+    }
+    void SetPoolIndex(u32 index_) noexcept {
+        index = index_;
+    }
+
     /// Get the opcode this microinstruction represents.
     [[nodiscard]] IR::Opcode GetOpcode() const noexcept {
         return op;
@@ -139,15 +207,15 @@ public:
 
     /// Get the number of arguments this instruction has.
     [[nodiscard]] size_t NumArgs() const {
-        return op == IR::Opcode::Phi ? phi_args.size() : NumArgsOf(op);
+        return op == IR::Opcode::Phi ? num_phi_args : NumArgsOf(op);
     }
 
     /// Get the value of a given argument index.
     [[nodiscard]] Value Arg(size_t index) const noexcept {
         if (op == IR::Opcode::Phi) {
-            return phi_args[index].second;
+            return PhiData().operands[index].use.value;
         } else {
-            return args[index];
+            return Slots()[index].value;
         }
     }
 
@@ -162,6 +230,8 @@ public:
     void Invalidate();
     void ClearArgs();
 
+    /// Rewrites every argument that uses this instruction to replacement. The instruction is
+    /// left without uses and can be removed from its block.
     void ReplaceUsesWith(Value replacement);
 
     void ReplaceOpcode(IR::Opcode opcode);
@@ -193,24 +263,56 @@ public:
     }
 
 private:
-    struct NonTriviallyDummy {
-        NonTriviallyDummy() noexcept {}
+    friend class InstPool;
+
+    /// Trailing storage of a phi node, in place of its argument slots.
+    struct PhiStorage {
+        PhiOperand* operands;
+        InstPool* pool;
     };
+    static constexpr u32 NumPhiSlots = 1;
+    static_assert(sizeof(PhiStorage) <= NumPhiSlots * sizeof(Use));
 
-    void Use(const Value& value);
-    void UndoUse(const Value& value);
+    /// Returns the number of argument slots that follow an instruction of the given opcode.
+    [[nodiscard]] static u32 NumSlotsOf(IR::Opcode op) noexcept {
+        return op == IR::Opcode::Phi ? NumPhiSlots : static_cast<u32>(NumArgsOf(op));
+    }
+
+    explicit Inst(IR::Opcode op_, u32 flags_, InstPool& pool) noexcept;
+    explicit Inst(const Inst& base, InstPool& pool);
+
+    [[nodiscard]] IR::Use* Slots() noexcept {
+        return reinterpret_cast<IR::Use*>(this + 1);
+    }
+    [[nodiscard]] const IR::Use* Slots() const noexcept {
+        return reinterpret_cast<const IR::Use*>(this + 1);
+    }
+    [[nodiscard]] PhiStorage& PhiData() noexcept {
+        return *reinterpret_cast<PhiStorage*>(this + 1);
+    }
+    [[nodiscard]] const PhiStorage& PhiData() const noexcept {
+        return *reinterpret_cast<const PhiStorage*>(this + 1);
+    }
 
+    void InitSlots() noexcept;
+
+    static void AddUse(IR::Use& use) noexcept;
+    static void RemoveUse(IR::Use& use) noexcept;
+
+    IR::Use* first_use{};
     IR::Opcode op{};
     int use_count{};
     u32 flags{};
     u32 definition{};
+    u32 index{};
     union {
-        NonTriviallyDummy dummy{};
-        boost::container::small_vector<std::pair<Block*, Value>, 2> phi_args;
-        std::array<Value, 5> args;
+        u32 num_slots;    ///< Argument slots after a non-phi instruction.
+        u32 num_phi_args; ///< Operands used in the segment of a phi node.
     };
 };
-static_assert(sizeof(Inst) <= 128, "Inst size unintentionally increased");
+static_assert(sizeof(Inst) <= 48, "Inst size unintentionally increased");
+static_assert(sizeof(Inst) % alignof(Use) == 0, "Argument slots must be aligned");
+static_assert(alignof(Inst) > 1, "Inst pointers must leave the immediate bit clear");
 
 using U1 = TypedValue<Type::U1>;
 using U8 = TypedValue<Type::U8>;
@@ -226,125 +328,71 @@ using F32F64 = TypedValue<Type::F32 | Type::F64>;
 using F16F32F64 = TypedValue<Type::F16 | Type::F32 | Type::F64>;
 using UAny = TypedValue<Type::U8 | Type::U16 | Type::U32 | Type::U64>;
 
-inline bool Value::IsIdentity() const noexcept {
-    return type == Type::Opaque && inst->GetOpcode() == Opcode::Identity;
-}
-
 inline bool Value::IsPhi() const noexcept {
-    return type == Type::Opaque && inst->GetOpcode() == Opcode::Phi;
+    return IsInst() && InstPointer()->GetOpcode() == Opcode::Phi;
 }
 
 inline bool Value::IsEmpty() const noexcept {
-    return type == Type::Void;
+    return raw == 0;
 }
 
 inline bool Value::IsImmediate() const noexcept {
-    IR::Type current_type{type};
-    const IR::Inst* current_inst{inst};
-    while (current_type == Type::Opaque && current_inst->GetOpcode() == Opcode::Identity) {
-        const Value& arg{current_inst->Arg(0)};
-        current_type = arg.type;
-        current_inst = arg.inst;
-    }
-    return current_type != Type::Opaque;
+    return !IsInst();
 }
 
 inline IR::Inst* Value::Inst() const {
-    DEBUG_ASSERT(type == Type::Opaque);
-    return inst;
-}
-
-inline IR::Inst* Value::InstRecursive() const {
-    DEBUG_ASSERT(type == Type::Opaque);
-    if (IsIdentity()) {
-        return inst->Arg(0).InstRecursive();
-    }
-    return inst;
-}
-
-inline IR::Inst* Value::TryInstRecursive() const {
-    if (IsIdentity()) {
-        return inst->Arg(0).TryInstRecursive();
-    }
-    return type == Type::Opaque ? inst : nullptr;
-}
-
-inline IR::Value Value::Resolve() const {
-    if (IsIdentity()) {
-        return inst->Arg(0).Resolve();
-    }
-    return *this;
+    DEBUG_ASSERT(IsInst());
+    return InstPointer();
 }
 
 inline IR::ScalarReg Value::ScalarReg() const {
-    DEBUG_ASSERT(type == Type::ScalarReg);
-    return sreg;
+    DEBUG_ASSERT(HasImmediateType(Type::ScalarReg));
+    return static_cast<IR::ScalarReg>(Payload());
 }
 
 inline IR::VectorReg Value::VectorReg() const {
-    DEBUG_ASSERT(type == Type::VectorReg);
-    return vreg;
+    DEBUG_ASSERT(HasImmediateType(Type::VectorReg));
+    return static_cast<IR::VectorReg>(Payload());
 }
 
 inline IR::Attribute Value::Attribute() const {
-    DEBUG_ASSERT(type == Type::Attribute);
-    return attribute;
+    DEBUG_ASSERT(HasImmediateType(Type::Attribute));
+    return static_cast<IR::Attribute>(Payload());
 }
 
 inline bool Value::U1() const {
-    if (IsIdentity()) {
-        return inst->Arg(0).U1();
-    }
-    DEBUG_ASSERT(type == Type::U1);
-    return imm_u1;
+    DEBUG_ASSERT(HasImmediateType(Type::U1));
+    return Payload() != 0;
 }
 
 inline u8 Value::U8() const {
-    if (IsIdentity()) {
-        return inst->Arg(0).U8();
-    }
-    DEBUG_ASSERT(type == Type::U8);
-    return imm_u8;
+    DEBUG_ASSERT(HasImmediateType(Type::U8));
+    return static_cast<u8>(Payload());
 }
 
 inline u16 Value::U16() const {
-    if (IsIdentity()) {
-        return inst->Arg(0).U16();
-    }
-    DEBUG_ASSERT(type == Type::U16);
-    return imm_u16;
+    DEBUG_ASSERT(HasImmediateType(Type::U16));
+    return static_cast<u16>(Payload());
 }
 
 inline u32 Value::U32() const {
-    if (IsIdentity()) {
-        return inst->Arg(0).U32();
-    }
-    DEBUG_ASSERT(type == Type::U32);
-    return imm_u32;
+    DEBUG_ASSERT(HasImmediateType(Type::U32));
+    return static_cast<u32>(Payload());
 }
 
 inline f32 Value::F32() const {
-    if (IsIdentity()) {
-        return inst->Arg(0).F32();
-    }
-    DEBUG_ASSERT(type == Type::F32);
-    return imm_f32;
+    DEBUG_ASSERT(HasImmediateType(Type::F32));
+    return std::bit_cast<f32>(static_cast<u32>(Payload()));
 }
 
 inline u64 Value::U64() const {
-    if (IsIdentity()) {
-        return inst->Arg(0).U64();
-    }
-    DEBUG_ASSERT(type == Type::U64);
-    return imm_u64;
+    DEBUG_ASSERT(HasImmediateType(Type::U64));
+    return Payload64();
 }
 
 inline f64 Value::F64() const {
-    if (IsIdentity()) {
-        return inst->Arg(0).F64();
-    }
-    DEBUG_ASSERT(type == Type::F64);
-    return imm_f64;
+    DEBUG_ASSERT(HasImmediateType(Type::F64));
+    return std::bit_cast<f64>(Payload64());
 }
 
 [[nodiscard]] inline bool IsPhi(const Inst& inst) {
@@ -7,9 +7,14 @@
 #include <type_traits>
 #include <utility>
 #include <vector>
+#include "common/types.h"
 
 namespace Shader {
 
+/// Objects that can store the index the pool gave them when they were created.
+template <typename T>
+concept PoolIndexed = requires(T& object, u32 index) { object.SetPoolIndex(index); };
+
 template <typename T>
     requires std::is_destructible_v<T>
 class ObjectPool {
@@ -21,7 +26,13 @@ public:
     template <typename... Args>
         requires std::is_constructible_v<T, Args...>
     [[nodiscard]] T* Create(Args&&... args) {
-        return std::construct_at(Memory(), std::forward<Args>(args)...);
+        T* const object{std::construct_at(Memory(), std::forward<Args>(args)...)};
+        // Objects are numbered in creation order, so indices stay dense until the next release.
+        if constexpr (PoolIndexed<T>) {
+            object->SetPoolIndex(static_cast<u32>(num_created));
+        }
+        ++num_created;
+        return object;
     }
 
     void ReleaseContents() {
@@ -40,6 +51,22 @@ public:
         }
         chunks.shrink_to_fit();
         node = &chunks.front();
+        num_created = 0;
+    }
+
+    /// Returns the number of objects created since the last release. Indices given to
+    /// PoolIndexed objects are below it.
+    [[nodiscard]] size_t NumObjects() const noexcept {
+        return num_created;
+    }
+
+    /// Returns the number of bytes held by the pool, used or not.
+    [[nodiscard]] size_t MemoryUsage() const noexcept {
+        size_t count{};
+        for (const Chunk& chunk : chunks) {
+            count += chunk.num_objects;
+        }
+        return count * sizeof(Storage);
     }
 
 private:
@@ -102,6 +129,7 @@ private:
     Chunk* node{};
     std::vector<Chunk> chunks;
     size_t new_chunk_size{};
+    size_t num_created{};
 };
 
 } // namespace Shader
@@ -9,11 +9,12 @@
 #include "ir/abstract_syntax_list.h"
 #include "ir/basic_block.h"
 #include "ir/post_order.h"
+#include "ir/program.h"
 #include "object_pool.h"
 
 namespace Shader::Optimization {
 void SsaRewritePass(IR::BlockList& program);
-void IdentityRemovalPass(IR::BlockList& program);
+void VerificationPass(const IR::Program& program);
 } // namespace Shader::Optimization
 
 namespace Shader::Recompiler {
@@ -35,31 +36,53 @@ Shader::IR::BlockList GenerateBlocks(const Shader::IR::AbstractSyntaxList& synta
     return blocks;
 }
 
-bool recompile_shader(const std::span<const u32>& code) {
-    Shader::Gcn::GcnCodeSlice slice(code.data(), code.data() + code.size());
-    std::vector<Shader::Gcn::GcnInst> insList;
-    Shader::Gcn::GcnDecodeContext decoder;
+namespace {
 
-    // Decode and save instructions
-    insList.reserve(code.size());
-    while (!slice.atEnd()) {
-        insList.emplace_back(decoder.decodeInstruction(slice));
+Shader::IR::Program BuildProgram(Shader::Gcn::CFG& cfg,
+                                 Shader::ObjectPool<Shader::IR::Block>& blk_pool,
+                                 Shader::IR::InstPool& inst_pool) {
+    Shader::IR::Program program;
+    program.syntax_list = Shader::Gcn::BuildASL(inst_pool, blk_pool, cfg);
+    program.blocks = GenerateBlocks(program.syntax_list);
+    program.post_order_blocks = Shader::IR::PostOrder(program.syntax_list.front());
+    if constexpr (Shader::IR::VerifyIR) {
+        Shader::Optimization::VerificationPass(program);
+    }
+    Shader::Optimization::SsaRewritePass(program.post_order_blocks);
+    if constexpr (Shader::IR::VerifyIR) {
+        Shader::Optimization::VerificationPass(program);
     }
+    return program;
+}
+
+} // Anonymous namespace
+
+std::string dump_shader(const std::span<const u32>& code) {
+    // Decode the instructions reachable from the entry point. Code may be followed by
+    // padding and the shader binary footer, which must not be decoded.
+    const auto reachable = Shader::Gcn::DecodeReachable(code);
+    const auto& insList = reachable.insts;
 
-    Shader::ObjectPool<Shader::Gcn::Block> block_pool{64};
     Shader::ObjectPool<Shader::IR::Block> blk_pool{64};
-    Shader::ObjectPool<Shader::IR::Inst> inst_pool{64};
-    Shader::Gcn::CFG cfg{block_pool, insList};
-    fmt::print("{}\n\n\n", cfg.Dot());
-    const auto ret = Shader::Gcn::BuildASL(inst_pool, blk_pool, cfg);
-    auto blocks = Shader::IR::PostOrder(ret.front());
-    auto block = GenerateBlocks(ret);
-    Shader::Optimization::SsaRewritePass(blocks);
-    Shader::Optimization::IdentityRemovalPass(block);
-    for (auto& blk : block) {
-        fmt::print("{}\n\n", Shader::IR::DumpBlock(*blk));
-    }
+    Shader::IR::InstPool inst_pool;
+    Shader::Gcn::CFG cfg{insList, reachable.pcs};
+    cfg.Simplify();
+    std::string ret{cfg.Dot() + "\n\n\n"};
+    ret += Shader::IR::DumpProgram(BuildProgram(cfg, blk_pool, inst_pool));
+    return ret;
+}
 
+Shader::IR::Program translate_shader(const std::span<const u32>& code,
+                                     Shader::ObjectPool<Shader::IR::Block>& blk_pool,
+                                     Shader::IR::InstPool& inst_pool) {
+    const auto reachable = Shader::Gcn::DecodeReachable(code);
+    Shader::Gcn::CFG cfg{reachable.insts, reachable.pcs};
+    cfg.Simplify();
+    return BuildProgram(cfg, blk_pool, inst_pool);
+}
+
+bool recompile_shader(const std::span<const u32>& code) {
+    fmt::print("{}", dump_shader(code));
     return true;
 }
 } // namespace Shader::Recompiler
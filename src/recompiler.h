@@ -4,10 +4,24 @@
 #pragma once
 
 #include <span>
+#include <string>
 #include "common/types.h"
+#include "ir/program.h"
+#include "object_pool.h"
 
 namespace Shader::Recompiler {
 
+/// Recompiles a shader and returns its control flow graph in dot format followed by its IR.
+/// Blocks and instructions are numbered in program order, so the output only depends on the
+/// code and identical shaders give identical bytes.
+[[nodiscard]] std::string dump_shader(const std::span<const u32>& code);
+
+/// Recompiles a shader into an IR program whose blocks and instructions are created by the
+/// given pools.
+[[nodiscard]] IR::Program translate_shader(const std::span<const u32>& code,
+                                           ObjectPool<IR::Block>& blk_pool,
+                                           IR::InstPool& inst_pool);
+
 bool recompile_shader(const std::span<const u32>& code);
 
 } // namespace Shader::Recompiler
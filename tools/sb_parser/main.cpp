@@ -1,17 +1,24 @@
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
 #include <vector>
 #include <fmt/core.h>
 #include <getopt.h>
 
 #include "common/assert.h"
+#include "exception.h"
+#include "frontend/decode.h"
+#include "frontend/disassembler.h"
 #include "recompiler.h"
 
 #include "shaderbinary.h"
 #include "strings.h"
+#include "synthetic.h"
 #include "types.h"
 #include "validate.h"
 
@@ -88,6 +95,105 @@ static void parseshadercode(const u8* code, uint32_t codesize) {
     }
 }
 
+static void benchmarkdecode(const u8* code, uint32_t codesize) {
+    using Clock = std::chrono::steady_clock;
+    constexpr u32 NumIterations = 1000;
+
+    const std::span<const u32> tokens{reinterpret_cast<const u32*>(code), codesize / sizeof(u32)};
+    const auto elapsed = [](Clock::time_point begin) {
+        return std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+    };
+
+    // Classify every dword, as a boundary scan would, and check the table against the masks.
+    for (const u32 token : tokens) {
+        ASSERT_MSG(Shader::Gcn::GetInstructionEncoding(token) ==
+                       Shader::Gcn::ClassifyInstructionEncoding(token),
+                   "encoding table mismatch for token {:#x}", token);
+    }
+    u64 checksum{};
+    auto begin = Clock::now();
+    for (u32 i = 0; i < NumIterations; i++) {
+        for (const u32 token : tokens) {
+            checksum += static_cast<u32>(Shader::Gcn::GetInstructionEncoding(token));
+        }
+    }
+    const double table_ns = elapsed(begin);
+    begin = Clock::now();
+    for (u32 i = 0; i < NumIterations; i++) {
+        for (const u32 token : tokens) {
+            checksum -= static_cast<u32>(Shader::Gcn::ClassifyInstructionEncoding(token));
+        }
+    }
+    const double masks_ns = elapsed(begin);
+    ASSERT(checksum == 0);
+
+    // Bulk classification of the whole stream, eight tokens at a time when supported.
+    std::vector<Shader::Gcn::EncodingInfo> encodings(tokens.size());
+    Shader::Gcn::ClassifyTokens(tokens, encodings);
+    for (size_t i = 0; i < tokens.size(); i++) {
+        const auto expected = Shader::Gcn::GetEncodingInfo(tokens[i]);
+        ASSERT_MSG(encodings[i].encoding == expected.encoding &&
+                       encodings[i].length == expected.length,
+                   "bulk classification mismatch for token {:#x}", tokens[i]);
+    }
+    begin = Clock::now();
+    for (u32 i = 0; i < NumIterations; i++) {
+        Shader::Gcn::ClassifyTokens(tokens, encodings);
+    }
+    const double bulk_ns = elapsed(begin);
+
+    // Full decode of the instruction stream. The binary ends with a footer and padding that do
+    // not decode, only the range of reachable code is timed.
+    const auto reachable = Shader::Gcn::DecodeReachable(tokens);
+    const auto code_tokens = tokens.first(reachable.end / sizeof(u32));
+    std::vector<Shader::Gcn::GcnInst> insts(code_tokens.size());
+    u64 num_insts{};
+    begin = Clock::now();
+    for (u32 i = 0; i < NumIterations; i++) {
+        num_insts += Shader::Gcn::DecodeRange(code_tokens, insts).num_insts;
+    }
+    const double decode_ns = elapsed(begin);
+
+    // Boundary scan followed by chunked decode.
+    double scan_ns{};
+    double parallel_ns{};
+    for (u32 i = 0; i < NumIterations; i++) {
+        begin = Clock::now();
+        const auto offsets = Shader::Gcn::ScanInstructionOffsets(code_tokens);
+        scan_ns += elapsed(begin);
+        begin = Clock::now();
+        Shader::Gcn::DecodeParallel(code_tokens, offsets, insts);
+        parallel_ns += elapsed(begin);
+    }
+
+    const double num_tokens = static_cast<double>(tokens.size()) * NumIterations;
+    fmt::print("Classify: table {:.2f} ns/token, masks {:.2f} ns/token\n", table_ns / num_tokens,
+               masks_ns / num_tokens);
+    fmt::print("Bulk classify ({}): {:.2f} ns/token\n",
+               Shader::Gcn::IsVectorClassifySupported() ? "avx2" : "scalar", bulk_ns / num_tokens);
+    fmt::print("Decode: {} instructions, {:.2f} ns/inst\n", num_insts / NumIterations,
+               decode_ns / static_cast<double>(num_insts));
+    fmt::print("Scan: {:.2f} ns/inst, parallel decode: {:.2f} ns/inst\n",
+               scan_ns / static_cast<double>(num_insts),
+               parallel_ns / static_cast<double>(num_insts));
+}
+
+/// Buffered disassembly is written out once it grows past this size.
+constexpr size_t DisassemblyFlushSize = 1 << 20;
+
+static void disassembleshader(const std::string& name, const u8* code, uint32_t codesize,
+                              fmt::memory_buffer& buffer, std::FILE* out) {
+    const std::span<const u32> tokens{reinterpret_cast<const u32*>(code), codesize / sizeof(u32)};
+    const auto reachable = Shader::Gcn::DecodeReachable(tokens);
+    fmt::format_to(std::back_inserter(buffer), "// {}\n", name);
+    Shader::Gcn::Disassemble(buffer, reachable.insts, reachable.pcs);
+    buffer.push_back('\n');
+    if (buffer.size() >= DisassemblyFlushSize) {
+        std::fwrite(buffer.data(), 1, buffer.size(), out);
+        buffer.clear();
+    }
+}
+
 static inline void printinputslot(const GnmInputUsageSlot* slot) {
     printf("Usage type: %s (%u)\n", gnmStrShaderInputUsageType(slot->usagetype), slot->usagetype);
     printf("API slot: %u\n", slot->apislot);
@@ -321,6 +427,22 @@ static void printgnmshaderfile(const PsslBinaryHeader* hdr) {
     parseshadercode((const u8*)shadercode, shadercodesize);
 }
 
+static const u8* gnmshadercode(const PsslBinaryHeader* hdr) {
+    const GnmShaderFileHeader* sfhdr = psslSbGnmShader(hdr);
+    const GnmShaderCommonData* common = gnmShfCommonData(sfhdr);
+
+    switch (sfhdr->type) {
+    case GNM_SHADER_VERTEX:
+        return (const u8*)gnmVsShaderCodePtr((const GnmVsShader*)common);
+    case GNM_SHADER_PIXEL:
+        return (const u8*)gnmPsShaderCodePtr((const GnmPsShader*)common);
+    case GNM_SHADER_COMPUTE:
+        return (const u8*)gnmCsShaderCodePtr((const GnmCsShader*)common);
+    default:
+        return nullptr;
+    }
+}
+
 static void printgnmshaderbininfo(const PsslBinaryHeader* hdr) {
     const GnmShaderBinaryInfo* bininfo = psslSbGnmShaderBinaryInfo(hdr);
 
@@ -519,6 +641,10 @@ static inline void printhelp(void) {
            "Usage: psb-dis [options] file\n"
            "Options:\n"
            "\t-b -- Batch processing\n"
+           "\t-t -- Time instruction decoding instead of recompiling\n"
+           "\t-d file -- Disassemble every input shader into file instead of recompiling\n"
+           "\t-s size -- Time structurization of synthetic shaders up to size, needs no file\n"
+           "\t-r size -- Check that recompiling synthetic shaders up to size is deterministic\n"
            "\t-h -- Show this help message\n");
 }
 
@@ -537,7 +663,13 @@ static std::vector<u8> read_file(const std::string& name) {
     return buffer;
 }
 
-static bool process_sb_file(const std::string& name) {
+/// Destination of the disassembly mode, shared by every processed file.
+struct Disassembly {
+    std::FILE* file{};
+    fmt::memory_buffer buffer;
+};
+
+static bool process_sb_file(const std::string& name, bool benchmark, Disassembly* disassembly) {
     const auto data = read_file(name);
     if (data.empty()) {
         fmt::print("Invalid file path: {}\n", name);
@@ -551,14 +683,41 @@ static bool process_sb_file(const std::string& name) {
         return 0;
     }
 
+    if (benchmark || disassembly) {
+        const auto* hdr = (const PsslBinaryHeader*)data.data();
+        const u8* code = gnmshadercode(hdr);
+        if (!code) {
+            printf("Unsupported shader type, skipping\n");
+            return 0;
+        }
+        const uint32_t codesize = psslSbGnmShaderBinaryInfo(hdr)->length;
+        try {
+            if (disassembly) {
+                disassembleshader(name, code, codesize, disassembly->buffer, disassembly->file);
+            } else {
+                benchmarkdecode(code, codesize);
+            }
+        } catch (const Shader::Exception& e) {
+            // Keep going through the rest of a batch
+            fmt::print("Failed to decode {}, skipping: {}\n", name, e.what());
+            return 0;
+        }
+        return 1;
+    }
+
     printshaderinfo(data.data());
+    return 1;
 }
 
 int main(int argc, char* argv[]) {
     bool batch_mode{};
+    bool benchmark{};
+    const char* disassemblyfile{};
+    u32 structurize_size{};
+    u32 determinism_size{};
 
     int c = -1;
-    while ((c = getopt(argc, argv, "hvb")) != -1) {
+    while ((c = getopt(argc, argv, "hvbtd:s:r:")) != -1) {
         switch (c) {
         case 'h': {
             printhelp();
@@ -568,16 +727,52 @@ int main(int argc, char* argv[]) {
             batch_mode = true;
             break;
         }
+        case 't': {
+            benchmark = true;
+            break;
+        }
+        case 'd': {
+            disassemblyfile = optarg;
+            break;
+        }
+        case 's': {
+            structurize_size = static_cast<u32>(std::strtoul(optarg, nullptr, 0));
+            break;
+        }
+        case 'r': {
+            determinism_size = static_cast<u32>(std::strtoul(optarg, nullptr, 0));
+            break;
+        }
         }
     }
 
+    if (structurize_size) {
+        benchmarkstructurize(structurize_size);
+        return EXIT_SUCCESS;
+    }
+    if (determinism_size) {
+        return checkdeterminism(determinism_size) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     const char* inputfile = argv[optind];
     if (!inputfile) {
         printf("Please pass an input file\n");
         return 0;
     }
 
+    Disassembly disassembly;
+    if (disassemblyfile) {
+        disassembly.file = std::fopen(disassemblyfile, "wb");
+        if (!disassembly.file) {
+            printf("Failed to open output file %s\n", disassemblyfile);
+            return EXIT_FAILURE;
+        }
+    }
+    Disassembly* const dis = disassemblyfile ? &disassembly : nullptr;
+
     if (batch_mode) {
+        // Directory iteration order is unspecified, sort so that output is stable.
+        std::vector<fs::path> paths;
         for (auto& node : fs::recursive_directory_iterator(inputfile)) {
             if (node.is_directory()) {
                 continue;
@@ -587,10 +782,19 @@ int main(int argc, char* argv[]) {
                 continue;
             }
 
-            process_sb_file(node.path().string());
+            paths.push_back(node.path());
+        }
+        std::ranges::sort(paths);
+        for (const fs::path& path : paths) {
+            process_sb_file(path.string(), benchmark, dis);
         }
     } else {
-        process_sb_file(inputfile);
+        process_sb_file(inputfile, benchmark, dis);
+    }
+
+    if (dis) {
+        std::fwrite(disassembly.buffer.data(), 1, disassembly.buffer.size(), disassembly.file);
+        std::fclose(disassembly.file);
     }
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,429 @@
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <fmt/core.h>
+
+#include "common/assert.h"
+#include "frontend/control_flow_graph.h"
+#include "frontend/decode.h"
+#include "frontend/opcodes.h"
+#include "frontend/structured_control_flow.h"
+#include "ir/basic_block.h"
+#include "ir/program.h"
+#include "ir/serialization.h"
+#include "object_pool.h"
+#include "recompiler.h"
+#include "synthetic.h"
+
+namespace {
+
+using Shader::Gcn::Opcode;
+
+/// s_mov_b32 s0, 0. The low byte selects an inline constant from 0 to 64.
+constexpr u32 FillerToken = 0xBE800380;
+constexpr u32 NumFillerValues = 65;
+/// v_mac_f32 v20, v21, v22. Blocks start by setting only the first 16 registers, so v20 is
+/// carried between blocks.
+constexpr u32 AccumulateToken = 0x3E282D15;
+/// s_endpgm
+constexpr u32 EndProgramToken = 0xBF810000;
+/// SOPP encoding bits, the opcode goes in bits 16-22 and the branch offset in the low half.
+constexpr u32 SoppToken = 0xBF800000;
+
+/// Emits single dword instructions, so instruction indices double as dword offsets.
+/// Branches only test scc, the other conditions are not translated yet.
+class ShaderBuilder {
+public:
+    /// Every filler moves another value, so traces of the program tell the blocks apart.
+    void Filler() {
+        code.push_back(FillerToken + num_fillers++ % NumFillerValues);
+    }
+
+    void Accumulate() {
+        code.push_back(AccumulateToken);
+    }
+
+    /// Emits a branch and returns its position, the target is set later with Patch.
+    size_t Branch(Opcode opcode) {
+        const u32 sopp_opcode = static_cast<u32>(opcode) -
+                                static_cast<u32>(Shader::Gcn::OpcodeMap::OP_MAP_SOPP);
+        code.push_back(SoppToken | sopp_opcode << 16);
+        return code.size() - 1;
+    }
+
+    /// Points the branch at position to target. Offsets are relative to the next instruction
+    /// and must fit in 16 bits, BranchesInRange tells whether any did not.
+    void Patch(size_t branch, size_t target) {
+        const auto offset = static_cast<s64>(target) - static_cast<s64>(branch + 1);
+        if (offset < std::numeric_limits<s16>::min() || offset > std::numeric_limits<s16>::max()) {
+            branches_in_range = false;
+            return;
+        }
+        code[branch] = (code[branch] & 0xFFFF0000) | static_cast<u16>(offset);
+    }
+
+    [[nodiscard]] bool BranchesInRange() const noexcept {
+        return branches_in_range;
+    }
+
+    [[nodiscard]] size_t Here() const noexcept {
+        return code.size();
+    }
+
+    [[nodiscard]] std::vector<u32> Finish() {
+        code.push_back(EndProgramToken);
+        return std::move(code);
+    }
+
+private:
+    std::vector<u32> code;
+    u32 num_fillers = 0;
+    bool branches_in_range = true;
+};
+
+/// Blocks linked by unconditional jumps, laid out in reverse so none of them fall through.
+void emitchain(ShaderBuilder& builder, u32 size) {
+    builder.Filler();
+    size_t jump = builder.Branch(Opcode::S_BRANCH);
+    std::vector<size_t> links;
+    for (u32 i = 0; i < size; i++) {
+        builder.Filler();
+        links.push_back(builder.Branch(Opcode::S_BRANCH));
+    }
+    // The entry jumps to the last block, every block then jumps to the one before it.
+    for (auto it = links.rbegin(); it != links.rend(); ++it) {
+        builder.Patch(jump, *it - 1);
+        jump = *it;
+    }
+    builder.Patch(jump, builder.Here());
+}
+
+/// Ifs nested size levels deep, with code before and after every inner if.
+void emitnestedifs(ShaderBuilder& builder, u32 size) {
+    std::vector<size_t> skips;
+    for (u32 i = 0; i < size; i++) {
+        builder.Filler();
+        skips.push_back(builder.Branch(Opcode::S_CBRANCH_SCC0));
+    }
+    builder.Filler();
+    for (auto it = skips.rbegin(); it != skips.rend(); ++it) {
+        builder.Filler();
+        builder.Patch(*it, builder.Here());
+    }
+}
+
+/// Loops nested size levels deep, each with a break out of its header. Headers and latches
+/// hold a single body instruction.
+void emitloopnest(ShaderBuilder& builder, u32 size, void (ShaderBuilder::*body)()) {
+    std::vector<std::pair<size_t, size_t>> loops; // Header and break
+    for (u32 i = 0; i < size; i++) {
+        const size_t header = builder.Here();
+        (builder.*body)();
+        loops.emplace_back(header, builder.Branch(Opcode::S_CBRANCH_SCC1));
+    }
+    for (auto it = loops.rbegin(); it != loops.rend(); ++it) {
+        (builder.*body)();
+        builder.Patch(builder.Branch(Opcode::S_CBRANCH_SCC0), it->first);
+        builder.Patch(it->second, builder.Here());
+    }
+    builder.Filler();
+}
+
+void emitloops(ShaderBuilder& builder, u32 size) {
+    emitloopnest(builder, size, &ShaderBuilder::Filler);
+}
+
+/// Loops that accumulate a float, so F32 register values flow through phis. The entry block
+/// comes before the outer loop, as the CFG has no edge into a header at pc 0 for the initial
+/// value.
+void emitfloatloops(ShaderBuilder& builder, u32 size) {
+    builder.Filler();
+    emitloopnest(builder, size, &ShaderBuilder::Accumulate);
+}
+
+/// A sequence of size cycles that are entered through both of their blocks.
+void emitirreducible(ShaderBuilder& builder, u32 size) {
+    for (u32 i = 0; i < size; i++) {
+        builder.Filler();
+        const size_t to_second = builder.Branch(Opcode::S_CBRANCH_SCC0);
+        const size_t first = builder.Here();
+        builder.Filler();
+        const size_t to_exit = builder.Branch(Opcode::S_CBRANCH_SCC1);
+        builder.Patch(to_second, builder.Here());
+        builder.Filler();
+        builder.Patch(builder.Branch(Opcode::S_CBRANCH_SCC0), first);
+        builder.Patch(to_exit, builder.Here());
+    }
+    builder.Filler();
+}
+
+struct Pattern {
+    const char* name;
+    void (*emit)(ShaderBuilder&, u32);
+};
+
+constexpr Pattern Patterns[] = {
+    {"chain", emitchain},
+    {"nested ifs", emitnestedifs},
+    {"loops", emitloops},
+    {"float loops", emitfloatloops},
+    {"irreducible", emitirreducible},
+};
+
+struct RoundTrips {
+    bool clone;
+    bool image;
+};
+
+/// Translates code and checks that a copy of the program made by CloneProgram and one read
+/// back from its binary image both dump and serialize the same as the original.
+RoundTrips checkroundtrips(std::span<const u32> code) {
+    Shader::ObjectPool<Shader::IR::Block> blk_pool{64};
+    Shader::IR::InstPool inst_pool;
+    const auto program = Shader::Recompiler::translate_shader(code, blk_pool, inst_pool);
+    const std::string dump = Shader::IR::DumpProgram(program);
+    const std::vector<u8> image = Shader::IR::SerializeProgram(program);
+
+    Shader::ObjectPool<Shader::IR::Block> clone_blk_pool{64};
+    Shader::IR::InstPool clone_inst_pool;
+    const auto clone = Shader::IR::CloneProgram(program, clone_blk_pool, clone_inst_pool);
+
+    Shader::ObjectPool<Shader::IR::Block> read_blk_pool{64};
+    Shader::IR::InstPool read_inst_pool;
+    const auto read = Shader::IR::DeserializeProgram(image, read_blk_pool, read_inst_pool);
+
+    return RoundTrips{
+        .clone = Shader::IR::DumpProgram(clone) == dump &&
+                 Shader::IR::SerializeProgram(clone) == image,
+        .image = Shader::IR::DumpProgram(read) == dump &&
+                 Shader::IR::SerializeProgram(read) == image,
+    };
+}
+
+/// Value of scc after the given number of traced instructions. Guest code is the only thing
+/// that may change it, so runs that agree on the code executed so far agree on the branches.
+bool sccafter(u64 seed, size_t num_traced) {
+    u64 x = seed + num_traced * 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return ((x ^ (x >> 31)) & 1) != 0;
+}
+
+std::string traceimmediate(const Shader::IR::Value& arg) {
+    using Shader::IR::Type;
+    switch (arg.Type()) {
+    case Type::U1:
+        return fmt::format("#{}", arg.U1());
+    case Type::U32:
+        return fmt::format("#{}", arg.U32());
+    case Type::F32:
+        return fmt::format("#{}", arg.F32());
+    case Type::ScalarReg:
+        return fmt::format("{}", arg.ScalarReg());
+    case Type::VectorReg:
+        return fmt::format("{}", arg.VectorReg());
+    default:
+        return fmt::format("#{}", arg.Type());
+    }
+}
+
+/// Runs the syntax list before SSA rewriting and returns the instructions it executes, one
+/// per line. Control flow, conditions and goto variables are evaluated instead of traced, so
+/// the structured and the goto eliminated form of a shader give the same trace. Stops after
+/// max_traced instructions, as loops may never exit.
+std::string tracesyntaxlist(const Shader::IR::AbstractSyntaxList& syntax_list, u64 seed,
+                            size_t max_traced) {
+    using Shader::IR::Opcode;
+    std::unordered_map<const Shader::IR::Inst*, bool> values;
+    std::unordered_map<u32, bool> goto_variables;
+    const auto eval = [&values](const Shader::IR::Value& value) {
+        return value.IsImmediate() ? value.U1() : values.at(value.Inst());
+    };
+    std::string trace;
+    size_t num_traced = 0;
+    // Blocks without code still have to end, give up on runs that stop making progress.
+    size_t steps_left = max_traced * 4 + 64;
+    const Shader::IR::Block* block = syntax_list.front().data.block;
+    while (block && num_traced < max_traced && steps_left-- > 0) {
+        bool cond = false;
+        for (const Shader::IR::Inst& inst : *block) {
+            switch (inst.GetOpcode()) {
+            case Opcode::GetScc:
+                values[&inst] = sccafter(seed, num_traced);
+                break;
+            case Opcode::ConditionRef:
+                cond = values[&inst] = eval(inst.Arg(0));
+                break;
+            case Opcode::LogicalNot:
+                values[&inst] = !eval(inst.Arg(0));
+                break;
+            case Opcode::LogicalOr:
+                values[&inst] = eval(inst.Arg(0)) || eval(inst.Arg(1));
+                break;
+            case Opcode::LogicalAnd:
+                values[&inst] = eval(inst.Arg(0)) && eval(inst.Arg(1));
+                break;
+            case Opcode::GetGotoVariable:
+                values[&inst] = goto_variables[inst.Arg(0).U32()];
+                break;
+            case Opcode::SetGotoVariable:
+                goto_variables[inst.Arg(0).U32()] = eval(inst.Arg(1));
+                break;
+            default:
+                trace += fmt::format("{}", inst.GetOpcode());
+                for (size_t arg = 0; arg < inst.NumArgs(); arg++) {
+                    const Shader::IR::Value value = inst.Arg(arg);
+                    trace += value.IsImmediate() ? " " + traceimmediate(value) : " %";
+                }
+                trace += '\n';
+                ++num_traced;
+                break;
+            }
+        }
+        // Blocks with two successors end in a condition that picks the first one.
+        const auto succs = block->ImmSuccessors();
+        block = succs.empty() ? nullptr : succs.size() == 1 || cond ? succs[0] : succs[1];
+    }
+    if (block && num_traced < max_traced) {
+        trace += "<no progress>\n";
+    }
+    return trace;
+}
+
+/// Structurizes code with and without goto elimination and checks that both syntax lists
+/// execute the same instructions for a few sequences of branch conditions.
+bool checkgotopass(std::span<const u32> code) {
+    constexpr u64 NumSeeds = 4;
+    constexpr size_t MaxTraced = 1 << 14;
+    const auto reachable = Shader::Gcn::DecodeReachable(code);
+    const auto build = [&reachable](Shader::ObjectPool<Shader::IR::Block>& block_pool,
+                                    Shader::IR::InstPool& inst_pool, Shader::Gcn::ASLPass pass) {
+        Shader::Gcn::CFG cfg{reachable.insts, reachable.pcs};
+        cfg.Simplify();
+        return Shader::Gcn::BuildASL(inst_pool, block_pool, cfg, nullptr, pass);
+    };
+    Shader::ObjectPool<Shader::IR::Block> auto_block_pool{64};
+    Shader::IR::InstPool auto_inst_pool;
+    const auto auto_list = build(auto_block_pool, auto_inst_pool, Shader::Gcn::ASLPass::Auto);
+    Shader::ObjectPool<Shader::IR::Block> goto_block_pool{64};
+    Shader::IR::InstPool goto_inst_pool;
+    const auto goto_list = build(goto_block_pool, goto_inst_pool, Shader::Gcn::ASLPass::Goto);
+    for (u64 seed = 0; seed < NumSeeds; seed++) {
+        if (tracesyntaxlist(auto_list, seed, MaxTraced) !=
+            tracesyntaxlist(goto_list, seed, MaxTraced)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // Anonymous namespace
+
+void benchmarkstructurize(u32 max_size) {
+    using Clock = std::chrono::steady_clock;
+    constexpr u32 NumIterations = 5;
+
+    const auto elapsed = [](Clock::time_point begin) {
+        return std::chrono::duration<double, std::micro>(Clock::now() - begin).count();
+    };
+
+    fmt::print("{:<12} {:>6} {:>7} {:>8} {:>10} {:>10} {:>10} {:>9} {:>6} {:>10}  {}\n",
+               "pattern", "size", "blocks", "stmts", "stmt KiB", "cfg us", "asl us", "ns/block",
+               "growth", "goto us", "pass");
+    for (const Pattern& pattern : Patterns) {
+        double last_asl_us{};
+        for (u32 size = 1; size <= max_size; size *= 2) {
+            ShaderBuilder builder;
+            pattern.emit(builder, size);
+            if (!builder.BranchesInRange()) {
+                // Larger sizes only branch further
+                fmt::print("{:<12} {:>6}  skipped, branches out of range\n", pattern.name, size);
+                break;
+            }
+            const std::vector<u32> code = builder.Finish();
+            std::vector<Shader::Gcn::GcnInst> insts(code.size());
+            const auto result = Shader::Gcn::DecodeRange(code, insts);
+            ASSERT(result.num_insts == code.size());
+
+            // Keep the fastest of a few runs to filter out noise.
+            double cfg_us = std::numeric_limits<double>::max();
+            double asl_us = std::numeric_limits<double>::max();
+            double goto_us = std::numeric_limits<double>::max();
+            size_t num_blocks{};
+            Shader::Gcn::ASLStats stats{};
+            for (u32 i = 0; i < NumIterations; i++) {
+                Shader::ObjectPool<Shader::IR::Block> block_pool{64};
+                Shader::IR::InstPool inst_pool;
+                auto begin = Clock::now();
+                Shader::Gcn::CFG cfg{insts, {}};
+                cfg.Simplify();
+                cfg_us = std::min(cfg_us, elapsed(begin));
+                num_blocks = cfg.blocks.size();
+
+                begin = Clock::now();
+                const auto syntax_list = Shader::Gcn::BuildASL(inst_pool, block_pool, cfg, &stats);
+                asl_us = std::min(asl_us, elapsed(begin));
+
+                // Same graph through goto elimination, to see what the direct path saves.
+                Shader::ObjectPool<Shader::IR::Block> goto_block_pool{64};
+                Shader::IR::InstPool goto_inst_pool;
+                Shader::Gcn::CFG goto_cfg{insts, {}};
+                goto_cfg.Simplify();
+                begin = Clock::now();
+                const auto goto_list = Shader::Gcn::BuildASL(goto_inst_pool, goto_block_pool,
+                                                             goto_cfg, nullptr,
+                                                             Shader::Gcn::ASLPass::Goto);
+                goto_us = std::min(goto_us, elapsed(begin));
+            }
+
+            // Doubling the size doubles the time of a linear pass and quadruples a quadratic one.
+            const double growth = last_asl_us > 0.0 ? asl_us / last_asl_us : 0.0;
+            last_asl_us = asl_us;
+            fmt::print("{:<12} {:>6} {:>7} {:>8} {:>10.1f} {:>10.1f} {:>10.1f} {:>9.1f} {:>6.2f} "
+                       "{:>10.1f}  {}\n",
+                       pattern.name, size, num_blocks, stats.num_statements,
+                       static_cast<double>(stats.statement_bytes) / 1024.0, cfg_us, asl_us,
+                       asl_us * 1000.0 / static_cast<double>(num_blocks), growth, goto_us,
+                       stats.used_goto_pass ? "goto" : "structured");
+        }
+    }
+}
+
+bool checkdeterminism(u32 max_size) {
+    bool identical = true;
+    for (const Pattern& pattern : Patterns) {
+        for (u32 size = 1; size <= max_size; size *= 2) {
+            ShaderBuilder builder;
+            pattern.emit(builder, size);
+            if (!builder.BranchesInRange()) {
+                fmt::print("{:<12} {:>6}  skipped, branches out of range\n", pattern.name, size);
+                break;
+            }
+            const std::vector<u32> code = builder.Finish();
+            const std::string first = Shader::Recompiler::dump_shader(code);
+
+            // Keep allocations of varying sizes alive, so the second run gets other addresses.
+            std::vector<std::unique_ptr<char[]>> holes;
+            for (size_t i = 0; i < 64; i++) {
+                holes.push_back(std::make_unique<char[]>(16 + i * 24));
+            }
+            const std::string second = Shader::Recompiler::dump_shader(code);
+
+            const bool same = first == second;
+            const RoundTrips round_trips = checkroundtrips(code);
+            const bool same_as_goto = checkgotopass(code);
+            identical &= same && round_trips.clone && round_trips.image && same_as_goto;
+            const auto result = [](bool equal) { return equal ? "identical" : "MISMATCH"; };
+            fmt::print("{:<12} {:>6} {:>9} bytes  {:<9}  clone {:<9}  image {:<9}  goto {}\n",
+                       pattern.name, size, first.size(), result(same),
+                       result(round_trips.clone), result(round_trips.image),
+                       result(same_as_goto));
+        }
+    }
+    return identical;
+}
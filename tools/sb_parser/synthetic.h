@@ -0,0 +1,14 @@
+#pragma once
+
+#include "common/types.h"
+
+/// Times CFG construction and structurization of synthetic shaders made of branch patterns,
+/// doubling their size until it reaches max_size or a branch no longer reaches its target.
+/// Goto elimination is timed on the same graphs for comparison.
+void benchmarkstructurize(u32 max_size);
+
+/// Recompiles the synthetic shaders up to max_size twice, with the heap in a different state
+/// each time, and checks that both outputs are identical. Also checks that a clone of each
+/// program and a copy read back from its binary image match the original, and that goto
+/// elimination runs the same code as the direct structurizer. Returns false on any difference.
+bool checkdeterminism(u32 max_size);